@@ -32,7 +32,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 35
+#define CINDEX_VERSION_MINOR 38
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -274,6 +274,20 @@ CINDEX_LINKAGE void clang_CXIndex_setGlobalOptions(CXIndex, unsigned options);
  */
 CINDEX_LINKAGE unsigned clang_CXIndex_getGlobalOptions(CXIndex);
 
+/**
+ * \brief Share precompiled preambles between the translation units of a
+ * CXIndex.
+ *
+ * Translation units created from this index whose preambles have the same
+ * contents and are built with the same options use a single precompiled
+ * preamble, stored in \p Path under a name derived from a hash of its
+ * contents. Passing NULL disables sharing for units created afterwards.
+ *
+ * \param Path An existing directory in which to store shared preambles.
+ */
+CINDEX_LINKAGE void clang_CXIndex_setSharedPreambleDirectory(CXIndex,
+                                                             const char *Path);
+
 /**
  * \defgroup CINDEX_FILES File manipulation routines
  *
@@ -1219,7 +1233,30 @@ enum CXTranslationUnit_Flags {
    * purposes of an IDE, this is undesirable behavior and as much information
    * as possible should be reported. Use this flag to enable this behavior.
    */
-  CXTranslationUnit_KeepGoing = 0x200
+  CXTranslationUnit_KeepGoing = 0x200,
+
+  /**
+   * \brief Used to indicate that the precompiled preamble should be rebuilt
+   * on a background thread.
+   *
+   * When a file in the preamble changes, \c clang_reparseTranslationUnit()
+   * starts building the new preamble and returns at once, keeping the old
+   * AST until the new preamble is adopted by the first reparse after the
+   * build finishes. This option only has an effect together with
+   * \c CXTranslationUnit_PrecompiledPreamble.
+   */
+  CXTranslationUnit_BackgroundPreamble = 0x400,
+
+  /**
+   * \brief Used to indicate that the detailed preprocessing record should
+   * only hold entities for the main file.
+   *
+   * Macro expansions and inclusion directives in other files are kept in a
+   * compact summary instead, which \c clang_getCursor() and
+   * \c clang_annotateTokens() do not see. This option only has an effect
+   * together with \c CXTranslationUnit_DetailedPreprocessingRecord.
+   */
+  CXTranslationUnit_MainFilePreprocessingRecord = 0x800
 };
 
 /**
@@ -4840,7 +4877,19 @@ enum CXCodeComplete_Flags {
    * \brief Whether to include brief documentation within the set of code
    * completions returned.
    */
-  CXCodeComplete_IncludeBriefComments = 0x04
+  CXCodeComplete_IncludeBriefComments = 0x04,
+
+  /**
+   * \brief Whether code completion may reuse the translation unit's parsed
+   * AST for the part of the main file that precedes the completion point.
+   *
+   * Only the declarations whose bodies contain the completion point are
+   * reparsed, instead of the whole main file. If the unsaved files change
+   * text before the completion point outside of the enclosing function, the
+   * parsed AST is not reused and completion reparses the whole main file,
+   * so the results are the same as without this flag.
+   */
+  CXCodeComplete_ReuseParsedAST = 0x08
 };
 
 /**
@@ -5153,6 +5202,92 @@ CXString clang_codeCompleteGetContainerUSR(CXCodeCompleteResults *Results);
  */
 CINDEX_LINKAGE
 CXString clang_codeCompleteGetObjCSelector(CXCodeCompleteResults *Results);
+
+/**
+ * \brief A code-completion session, which computes the completions at one
+ * location once and lets the client filter and page through them as the
+ * user keeps typing.
+ */
+typedef void *CXCodeCompleteSession;
+
+/**
+ * \brief Start a code-completion session at the given location.
+ *
+ * The parameters have the same meaning as for \c clang_codeCompleteAt().
+ * Completion results are collected on the calling thread, then scored and
+ * ranked on a worker thread, so this function returns as soon as the
+ * results are collected. The session holds a reference to \p TU, which must
+ * not be reparsed or disposed of until the session is disposed of.
+ *
+ * \returns a new session, which must be freed with
+ * \c clang_codeCompleteSession_dispose(), or NULL if code completion fails.
+ */
+CINDEX_LINKAGE
+CXCodeCompleteSession
+clang_codeCompleteSession_create(CXTranslationUnit TU,
+                                 const char *complete_filename,
+                                 unsigned complete_line,
+                                 unsigned complete_column,
+                                 struct CXUnsavedFile *unsaved_files,
+                                 unsigned num_unsaved_files,
+                                 unsigned options);
+
+/**
+ * \brief Restrict the session's results to those whose typed text matches
+ * the given prefix, ignoring case.
+ *
+ * If \p prefix extends the previous filter, only the results that matched
+ * the previous filter are examined again, so filtering as the user types
+ * costs time proportional to the remaining results rather than to all of
+ * them. Passing an empty string clears the filter.
+ */
+CINDEX_LINKAGE
+void clang_codeCompleteSession_setFilter(CXCodeCompleteSession Session,
+                                         const char *prefix);
+
+/**
+ * \brief Determine whether the session's worker thread has finished ranking
+ * the results for the current filter.
+ *
+ * \param wait If non-zero, block until ranking is finished.
+ *
+ * \returns non-zero if the results are ranked.
+ */
+CINDEX_LINKAGE
+unsigned clang_codeCompleteSession_isRanked(CXCodeCompleteSession Session,
+                                            unsigned wait);
+
+/**
+ * \brief Retrieve the number of results that match the current filter.
+ */
+CINDEX_LINKAGE
+unsigned clang_codeCompleteSession_getNumResults(CXCodeCompleteSession Session);
+
+/**
+ * \brief Retrieve a page of the results that match the current filter, in
+ * rank order.
+ *
+ * If ranking has not finished, this waits for it.
+ *
+ * \param first The index of the first result to return.
+ *
+ * \param max_results The maximum number of results to return.
+ *
+ * \returns a new \c CXCodeCompleteResults structure with at most
+ * \p max_results results, which must be freed with
+ * \c clang_disposeCodeCompleteResults(). The completion strings it refers
+ * to remain valid until the session is disposed of.
+ */
+CINDEX_LINKAGE
+CXCodeCompleteResults *
+clang_codeCompleteSession_getResults(CXCodeCompleteSession Session,
+                                     unsigned first, unsigned max_results);
+
+/**
+ * \brief Free the given code-completion session.
+ */
+CINDEX_LINKAGE
+void clang_codeCompleteSession_dispose(CXCodeCompleteSession Session);
   
 /**
  * @}
@@ -23,6 +23,7 @@
 #include "clang/AST/NestedNameSpecifier.h"
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/AST/RawCommentList.h"
+#include "clang/AST/SharedBuiltinTypes.h"
 #include "clang/AST/TemplateName.h"
 #include "clang/AST/Type.h"
 #include "clang/Basic/AddressSpaces.h"
@@ -454,6 +455,10 @@ private:
   const TargetInfo *Target;
   const TargetInfo *AuxTarget;
   clang::PrintingPolicy PrintingPolicy;
+
+  /// \brief The arena providing the builtin type nodes, or null if this
+  /// context allocates its own.
+  IntrusiveRefCntPtr<SharedBuiltinTypes> SharedBuiltins;
   
 public:
   IdentifierTable &Idents;
@@ -2489,11 +2494,30 @@ private:
   void operator=(const ASTContext &) = delete;
 
 public:
+  /// \brief Use the builtin type nodes of the given arena instead of
+  /// allocating them in this context.
+  ///
+  /// This must be called before \c InitBuiltinTypes().
+  void setSharedBuiltinTypes(IntrusiveRefCntPtr<SharedBuiltinTypes> Shared) {
+    assert(!VoidTy.getTypePtrOrNull() && "Builtin types already initialized");
+    SharedBuiltins = std::move(Shared);
+  }
+
+  /// \brief Retrieve the arena providing the builtin type nodes, if any.
+  SharedBuiltinTypes *getSharedBuiltinTypes() const {
+    return SharedBuiltins.get();
+  }
+
   /// \brief Initialize built-in types.
   ///
   /// This routine may only be invoked once for a given ASTContext object.
   /// It is normally invoked after ASTContext construction.
   ///
+  /// If a \c SharedBuiltinTypes arena was set, its nodes are registered in
+  /// this context instead of new ones. \c Types holds non-const pointers,
+  /// so the shared nodes are added to it with a \c const_cast; they are
+  /// never modified through it.
+  ///
   /// \param Target The target
   void InitBuiltinTypes(const TargetInfo &Target,
                         const TargetInfo *AuxTarget = nullptr);
@@ -0,0 +1,68 @@
+//===--- SharedBuiltinTypes.h - Shared builtin type nodes -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Defines the clang::SharedBuiltinTypes class, a read-only arena of
+/// builtin type nodes that any number of ASTContexts can share.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_SHAREDBUILTINTYPES_H
+#define LLVM_CLANG_AST_SHAREDBUILTINTYPES_H
+
+#include "clang/AST/Type.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/Support/Allocator.h"
+
+namespace clang {
+
+/// \brief An immutable set of \c BuiltinType nodes, one for each builtin type
+/// kind.
+///
+/// Builtin type nodes do not refer to their context or to the target: the
+/// target only decides which kinds the context's \c CanQualType members
+/// (e.g., \c WCharTy) name. An ASTContext that is given a
+/// \c SharedBuiltinTypes before \c InitBuiltinTypes() is called uses these
+/// nodes instead of allocating its own, so tools that create many contexts
+/// build the builtin types once per process.
+///
+/// The cached linkage and visibility of every node is computed before the
+/// arena is published, so contexts on different threads never write to a
+/// shared node.
+class SharedBuiltinTypes
+    : public llvm::ThreadSafeRefCountedBase<SharedBuiltinTypes> {
+  llvm::BumpPtrAllocator Allocator;
+  BuiltinType *Types[BuiltinType::LastKind + 1];
+
+  SharedBuiltinTypes();
+  SharedBuiltinTypes(const SharedBuiltinTypes &) = delete;
+  void operator=(const SharedBuiltinTypes &) = delete;
+
+public:
+  /// \brief Retrieve the process-wide arena, creating it on first use.
+  static IntrusiveRefCntPtr<SharedBuiltinTypes> get();
+
+  /// \brief Retrieve the node for the given builtin type kind.
+  ///
+  /// ASTContext::Types holds non-const pointers, so \c InitBuiltinType()
+  /// registers the node there with a \c const_cast. That is safe because a
+  /// context never modifies a builtin type node once it exists: their
+  /// cached linkage is computed before the arena is published.
+  const BuiltinType *getType(BuiltinType::Kind K) const {
+    assert(K <= BuiltinType::LastKind && "Invalid builtin type kind");
+    return Types[K];
+  }
+
+  /// \brief Retrieve the amount of memory used by the arena.
+  size_t getTotalMemory() const { return Allocator.getTotalMemory(); }
+};
+
+} // end namespace clang
+
+#endif
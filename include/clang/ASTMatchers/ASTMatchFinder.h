@@ -121,12 +121,32 @@ public:
   };
 
   struct MatchFinderOptions {
+    /// \brief Statistics for a single registered matcher.
+    struct MatcherProfile {
+      /// \brief Time spent evaluating the matcher.
+      llvm::TimeRecord Time;
+
+      /// \brief The number of nodes the matcher was evaluated on.
+      unsigned Attempts;
+
+      /// \brief The number of nodes the matcher matched.
+      unsigned Matches;
+
+      MatcherProfile() : Attempts(0), Matches(0) {}
+    };
+
     struct Profiling {
-      Profiling(llvm::StringMap<llvm::TimeRecord> &Records)
-          : Records(Records) {}
+      Profiling(llvm::StringMap<llvm::TimeRecord> &Records,
+                llvm::StringMap<MatcherProfile> *Matchers = nullptr)
+          : Records(Records), Matchers(Matchers) {}
 
       /// \brief Per bucket timing information.
       llvm::StringMap<llvm::TimeRecord> &Records;
+
+      /// \brief Per matcher statistics, if requested, keyed by the bucket
+      /// followed by '#' and the index of the matcher among the matchers
+      /// registered for that bucket, e.g. "misc-foo#0".
+      llvm::StringMap<MatcherProfile> *Matchers;
     };
 
     /// \brief Enables per-check timers.
@@ -190,6 +210,12 @@ public:
   /// \brief Finds all matches in the given AST.
   void matchAST(ASTContext &Context);
 
+  /// \brief Prints a per matcher profile, one line per matcher, sorted by
+  /// decreasing time.
+  static void printMatcherProfile(
+      const llvm::StringMap<MatchFinderOptions::MatcherProfile> &Profile,
+      raw_ostream &OS);
+
   /// \brief Registers a callback to notify the end of parsing.
   ///
   /// The provided closure is called after parsing is done, before the AST is
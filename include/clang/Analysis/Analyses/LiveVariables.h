@@ -16,6 +16,7 @@
 
 #include "clang/AST/Decl.h"
 #include "clang/Analysis/AnalysisContext.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/ImmutableSet.h"
 
@@ -29,23 +30,47 @@ class SourceManager;
   
 class LiveVariables : public ManagedAnalysis {
 public:
+  /// A dense numbering of the variables referenced by the analyzed body,
+  /// used to index the bit vectors of live variables.
+  typedef llvm::DenseMap<const VarDecl *, unsigned> VarIndexMap;
+
   class LivenessValues {
   public:
 
     llvm::ImmutableSet<const Stmt *> liveStmts;
-    llvm::ImmutableSet<const VarDecl *> liveDecls;
+
+    /// The live variables, one bit per variable in \c DeclIndex. Merging
+    /// and comparing the values of two blocks is done a word at a time,
+    /// which keeps functions with thousands of variables and blocks fast.
+    ///
+    /// Unlike ImmutableSets, bit vectors share no storage, so the analysis
+    /// keeps them only at block boundaries; see
+    /// \c LiveVariables::isLive(const Stmt *, const VarDecl *).
+    llvm::BitVector liveDecls;
+
+    /// The numbering of the variables, shared by all the values computed by
+    /// one analysis. Null only for default-constructed values.
+    const VarIndexMap *DeclIndex;
     
     bool equals(const LivenessValues &V) const;
 
     LivenessValues()
-      : liveStmts(nullptr), liveDecls(nullptr) {}
+      : liveStmts(nullptr), DeclIndex(nullptr) {}
 
     LivenessValues(llvm::ImmutableSet<const Stmt *> LiveStmts,
-                   llvm::ImmutableSet<const VarDecl *> LiveDecls)
-      : liveStmts(LiveStmts), liveDecls(LiveDecls) {}
+                   llvm::BitVector LiveDecls, const VarIndexMap *DeclIndex)
+      : liveStmts(LiveStmts), liveDecls(std::move(LiveDecls)),
+        DeclIndex(DeclIndex) {}
 
     bool isLive(const Stmt *S) const;
-    bool isLive(const VarDecl *D) const;
+
+    bool isLive(const VarDecl *D) const {
+      if (!DeclIndex)
+        return false;
+      VarIndexMap::const_iterator I = DeclIndex->find(D);
+      return I != DeclIndex->end() && I->second < liveDecls.size() &&
+             liveDecls.test(I->second);
+    }
     
     friend class LiveVariables;    
   };
@@ -69,6 +94,10 @@ public:
   ~LiveVariables() override;
 
   /// Compute the liveness information for a given CFG.
+  ///
+  /// Blocks are visited in post order, which for this backward analysis
+  /// means successors are processed before their predecessors, so most
+  /// blocks reach their fixed point after a single visit.
   static LiveVariables *computeLiveness(AnalysisDeclContext &analysisContext,
                                         bool killAtAssign);
   
@@ -80,6 +109,14 @@ public:
   ///  the statement.  This query only works if liveness information
   ///  has been recorded at the statement level (see runOnAllBlocks), and
   ///  only returns liveness information for block-level expressions.
+  ///
+  ///  Only the live variables at the end of each block are stored. The
+  ///  values for the statements of a block are recomputed on demand by
+  ///  replaying the block's transfer function, and kept for the most
+  ///  recently queried block only, so memory stays proportional to blocks
+  ///  times variables rather than statements times variables. Clients such
+  ///  as the analyzer query the statements of one block in a row, so each
+  ///  block is replayed about once per visit.
   bool isLive(const Stmt *S, const VarDecl *D);
   
   /// Returns true the block-level expression "value" is live
@@ -212,6 +212,12 @@ private:
 /// We traverse the blocks in the CFG, compute the set of mutexes that are held
 /// at the end of each block, and issue warnings for thread safety violations.
 /// Each block in the CFG is traversed exactly once.
+///
+/// \p Bset holds the state shared by all the functions analyzed in a
+/// translation unit: the acquired_before/after relations, the cached
+/// translations of attribute expressions (see \c AttrTranslationCache), and
+/// the factory of the hash-consed lock sets. It is created on first use and
+/// released with \c threadSafetyCleanup().
 void runThreadSafetyAnalysis(AnalysisDeclContext &AC,
                              ThreadSafetyHandler &Handler,
                              BeforeSet **Bset);
@@ -27,6 +27,8 @@
 #include "clang/Analysis/Analyses/ThreadSafetyTraverse.h"
 #include "clang/Analysis/AnalysisContext.h"
 #include "clang/Basic/OperatorKinds.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Allocator.h"
 #include <memory>
 #include <ostream>
 #include <sstream>
@@ -310,6 +312,60 @@ public:
 };
 
 
+// Caches the translations of attribute expressions that do not depend on a
+// call site, such as the capabilities named by guarded_by on a field or by
+// requires_capability on a function, as seen from within that function.
+// One cache is shared by the SExprBuilders of all the functions analyzed in
+// a translation unit, so each such expression is translated only once.
+//
+// The cache owns the arena the cached expressions are allocated in, and the
+// variable that stands for 'this' in them, which every builder using the
+// cache adopts as its own.
+class AttrTranslationCache {
+public:
+  AttrTranslationCache()
+      : Arena(&Allocator), SelfVar(nullptr), NumHits(0), NumMisses(0) {
+    SelfVar = new (Arena) til::Variable(nullptr);
+    SelfVar->setKind(til::Variable::VK_SFun);
+  }
+
+  AttrTranslationCache(const AttrTranslationCache &) = delete;
+  void operator=(const AttrTranslationCache &) = delete;
+
+  til::MemRegionRef getArena() { return Arena; }
+  til::Variable *getSelfVar() const { return SelfVar; }
+
+  // Return the cached translation of AttrExp, attached to D, or null.
+  const CapabilityExpr *lookup(const Expr *AttrExp, const NamedDecl *D) {
+    auto It = Translations.find(std::make_pair(AttrExp, D));
+    if (It == Translations.end()) {
+      ++NumMisses;
+      return nullptr;
+    }
+    ++NumHits;
+    return &It->second;
+  }
+
+  // Record the translation of AttrExp, attached to D.  The expression must
+  // have been allocated in this cache's arena.
+  void insert(const Expr *AttrExp, const NamedDecl *D, CapabilityExpr E) {
+    Translations.insert(std::make_pair(std::make_pair(AttrExp, D), E));
+  }
+
+  unsigned getNumHits() const { return NumHits; }
+  unsigned getNumMisses() const { return NumMisses; }
+
+private:
+  llvm::BumpPtrAllocator Allocator;
+  til::MemRegionRef Arena;
+  til::Variable *SelfVar;
+  llvm::DenseMap<std::pair<const Expr *, const NamedDecl *>, CapabilityExpr>
+      Translations;
+  unsigned NumHits;
+  unsigned NumMisses;
+};
+
+
 
 // Translate clang::Expr to til::SExpr.
 class SExprBuilder {
@@ -338,13 +394,22 @@ public:
   };
 
   SExprBuilder(til::MemRegionRef A)
-      : Arena(A), SelfVar(nullptr), Scfg(nullptr), CurrentBB(nullptr),
-        CurrentBlockInfo(nullptr) {
+      : Arena(A), SelfVar(nullptr), TransCache(nullptr), Scfg(nullptr),
+        CurrentBB(nullptr), CurrentBlockInfo(nullptr) {
     // FIXME: we don't always have a self-variable.
     SelfVar = new (Arena) til::Variable(nullptr);
     SelfVar->setKind(til::Variable::VK_SFun);
   }
 
+  // Share translations of attribute expressions through Cache.  Attribute
+  // expressions translated without a DeclExp or SelfDecl are then looked up
+  // in, or translated into, the cache.
+  void setAttrTranslationCache(AttrTranslationCache *Cache) {
+    TransCache = Cache;
+    if (Cache)
+      SelfVar = Cache->getSelfVar();
+  }
+
   // Translate a clang expression in an attribute to a til::SExpr.
   // Constructs the context from D, DeclExp, and SelfDecl.
   CapabilityExpr translateAttrExpr(const Expr *AttrExp, const NamedDecl *D,
@@ -477,6 +542,7 @@ private:
 
   til::MemRegionRef Arena;
   til::Variable *SelfVar;       // Variable to use for 'this'.  May be null.
+  AttrTranslationCache *TransCache; // Shared attribute translations, or null.
 
   til::SCFG *Scfg;
   StatementMap SMap;                       // Map from Stmt to TIL Variables
@@ -15,12 +15,18 @@
 #define LLVM_CLANG_ANALYSIS_ANALYSES_THREADSAFETYUTIL_H
 
 #include "clang/AST/ExprCXX.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/AlignOf.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iterator>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -339,6 +345,133 @@ private:
   VectorData *Data;
 };
 
+// An immutable, sorted set of unsigned IDs.  Sets are hash-consed by the
+// IDSetFactory that creates them, so equal sets share one copy of their
+// elements and compare equal in constant time.  The thread safety analysis
+// uses them for lock sets, which are otherwise copied at every CFG join.
+class IDSetFactory {
+  struct Node : public llvm::FoldingSetNode {
+    unsigned Size;
+
+    const unsigned *elements() const {
+      return reinterpret_cast<const unsigned *>(this + 1);
+    }
+
+    static void Profile(llvm::FoldingSetNodeID &ID, ArrayRef<unsigned> Elts) {
+      ID.AddInteger(Elts.size());
+      for (unsigned E : Elts)
+        ID.AddInteger(E);
+    }
+
+    void Profile(llvm::FoldingSetNodeID &ID) const {
+      Profile(ID, ArrayRef<unsigned>(elements(), Size));
+    }
+  };
+
+public:
+  class Set {
+    const Node *N;
+
+    explicit Set(const Node *N) : N(N) {}
+    friend class IDSetFactory;
+
+  public:
+    // The empty set.  get() returns this for empty input, so every empty set
+    // compares equal.
+    Set() : N(nullptr) {}
+
+    ArrayRef<unsigned> elements() const {
+      return N ? ArrayRef<unsigned>(N->elements(), N->Size)
+               : ArrayRef<unsigned>();
+    }
+
+    typedef ArrayRef<unsigned>::iterator iterator;
+    iterator begin() const { return elements().begin(); }
+    iterator end() const { return elements().end(); }
+    unsigned size() const { return N ? N->Size : 0; }
+    bool empty() const { return size() == 0; }
+
+    bool contains(unsigned ID) const {
+      return std::binary_search(begin(), end(), ID);
+    }
+
+    bool operator==(Set Other) const { return N == Other.N; }
+    bool operator!=(Set Other) const { return N != Other.N; }
+  };
+
+  IDSetFactory() {}
+  IDSetFactory(const IDSetFactory &) = delete;
+  void operator=(const IDSetFactory &) = delete;
+
+  Set getEmptySet() { return Set(); }
+
+  // Return the set holding Elts, which must be sorted and free of duplicates.
+  Set get(ArrayRef<unsigned> Elts) {
+    if (Elts.empty())
+      return Set();
+    llvm::FoldingSetNodeID ID;
+    Node::Profile(ID, Elts);
+    void *InsertPos;
+    if (Node *N = Nodes.FindNodeOrInsertPos(ID, InsertPos))
+      return Set(N);
+    size_t Bytes = sizeof(Node) + Elts.size() * sizeof(unsigned);
+    void *Mem = Allocator.Allocate(Bytes, llvm::alignOf<Node>());
+    Node *N = new (Mem) Node();
+    N->Size = Elts.size();
+    std::copy(Elts.begin(), Elts.end(), reinterpret_cast<unsigned *>(N + 1));
+    Nodes.InsertNode(N, InsertPos);
+    return Set(N);
+  }
+
+  Set add(Set S, unsigned ID) {
+    ArrayRef<unsigned> Elts = S.elements();
+    const unsigned *Pos = std::lower_bound(Elts.begin(), Elts.end(), ID);
+    if (Pos != Elts.end() && *Pos == ID)
+      return S;
+    SmallVector<unsigned, 8> NewElts(Elts.begin(), Pos);
+    NewElts.push_back(ID);
+    NewElts.append(Pos, Elts.end());
+    return get(NewElts);
+  }
+
+  Set remove(Set S, unsigned ID) {
+    ArrayRef<unsigned> Elts = S.elements();
+    const unsigned *Pos = std::lower_bound(Elts.begin(), Elts.end(), ID);
+    if (Pos == Elts.end() || *Pos != ID)
+      return S;
+    SmallVector<unsigned, 8> NewElts(Elts.begin(), Pos);
+    NewElts.append(Pos + 1, Elts.end());
+    return get(NewElts);
+  }
+
+  // Return the intersection of A and B.  Results are memoized, since the
+  // same pairs of sets meet at many joins.
+  Set intersect(Set A, Set B) {
+    if (A == B || A.empty())
+      return A;
+    if (B.empty())
+      return B;
+    if (B.N < A.N)
+      std::swap(A, B);
+    auto Key = std::make_pair(A.N, B.N);
+    auto Known = Intersections.find(Key);
+    if (Known != Intersections.end())
+      return Set(Known->second);
+    SmallVector<unsigned, 8> Elts;
+    std::set_intersection(A.begin(), A.end(), B.begin(), B.end(),
+                          std::back_inserter(Elts));
+    Set Result = get(Elts);
+    Intersections[Key] = Result.N;
+    return Result;
+  }
+
+private:
+  llvm::BumpPtrAllocator Allocator;
+  llvm::FoldingSet<Node> Nodes;
+  llvm::DenseMap<std::pair<const Node *, const Node *>, const Node *>
+      Intersections;
+};
+
 inline std::ostream& operator<<(std::ostream& ss, const StringRef str) {
   return ss.write(str.data(), str.size());
 }
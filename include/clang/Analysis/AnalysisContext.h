@@ -20,8 +20,10 @@
 #include "clang/Analysis/CodeInjector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Allocator.h"
 #include <memory>
+#include <utility>
 
 namespace clang {
 
@@ -61,6 +63,83 @@ public:
 };
 
 
+/// A cache of CFGs for one translation unit, shared by every client that
+/// analyzes its function bodies (e.g. AnalysisBasedWarnings, the static
+/// analyzer and AST matcher based checks).
+///
+/// CFGs are keyed by declaration, by the body they were built from and by
+/// the build options that shape them, so clients with different options or
+/// with different bodies for the same declaration (e.g. one synthesized by
+/// a BodyFarm) each get the CFG they asked for, and clients with the same
+/// options build it only once. CFGs built with options that are not
+/// shareable are never cached.
+///
+/// The cache is not synchronized: all of its clients must run on the same
+/// thread. Clients that analyze a translation unit in parallel must not set
+/// it (the static analyzer parallelizes across processes instead; see
+/// \c AnalyzerOptions::getAnalysisShardCount()).
+class CFGCache {
+public:
+  struct Stats {
+    /// The number of requests answered from the cache.
+    unsigned Hits;
+    /// The number of CFGs built and added to the cache.
+    unsigned Misses;
+    /// The number of CFGs built for options that cannot be shared.
+    unsigned Unshareable;
+
+    Stats() : Hits(0), Misses(0), Unshareable(0) {}
+  };
+
+private:
+  struct Entry {
+    const Stmt *Body;
+    /// The options the CFG was built with. \c forcedBlkExprs is cleared,
+    /// since it points into the context that requested the CFG.
+    CFG::BuildOptions Options;
+    std::shared_ptr<CFG> Graph;
+  };
+  llvm::DenseMap<const Decl *, SmallVector<Entry, 2>> Entries;
+  Stats CacheStats;
+
+public:
+  /// Returns the CFG of \p Body, the body of \p D, built with \p Options,
+  /// building it if necessary. Returns null if the CFG cannot be built;
+  /// failures are cached as well.
+  std::shared_ptr<CFG> getCFG(const Decl *D, Stmt *Body,
+                              const CFG::BuildOptions &Options) {
+    if (!Options.isShareable()) {
+      ++CacheStats.Unshareable;
+      return CFG::buildCFG(D, Body, &D->getASTContext(), Options);
+    }
+    SmallVectorImpl<Entry> &ForDecl = Entries[D];
+    for (const Entry &E : ForDecl)
+      if (E.Body == Body && E.Options.buildsSameCFGAs(Options)) {
+        ++CacheStats.Hits;
+        return E.Graph;
+      }
+    ++CacheStats.Misses;
+    std::shared_ptr<CFG> Result =
+        CFG::buildCFG(D, Body, &D->getASTContext(), Options);
+    Entry New;
+    New.Body = Body;
+    New.Options = Options;
+    New.Options.forcedBlkExprs = nullptr;
+    New.Graph = Result;
+    ForDecl.push_back(std::move(New));
+    return Result;
+  }
+
+  /// Drops the CFGs of \p D, e.g. because its body changed. Clients that
+  /// hold one of them keep it alive.
+  void invalidate(const Decl *D) { Entries.erase(D); }
+
+  /// Drops every CFG.
+  void clear() { Entries.clear(); }
+
+  const Stats &getStats() const { return CacheStats; }
+};
+
 /// AnalysisDeclContext contains the context data for the function or method
 /// under analysis.
 class AnalysisDeclContext {
@@ -70,9 +149,12 @@ class AnalysisDeclContext {
 
   const Decl * const D;
 
-  std::unique_ptr<CFG> cfg, completeCFG;
+  std::shared_ptr<CFG> cfg, completeCFG;
   std::unique_ptr<CFGStmtMap> cfgStmtMap;
 
+  /// The cache the CFGs are taken from, or null to build them privately.
+  CFGCache *SharedCFGs;
+
   CFG::BuildOptions cfgBuildOptions;
   CFG::BuildOptions::ForcedBlkExprs *forcedBlkExprs;
 
@@ -126,6 +208,14 @@ public:
   bool getAddImplicitDtors() const { return cfgBuildOptions.AddImplicitDtors; }
   bool getAddInitializers() const { return cfgBuildOptions.AddInitializers; }
 
+  /// Take the CFGs of this context from \p Cache instead of building them
+  /// privately. Must be called before the CFG is first requested.
+  void setCFGCache(CFGCache *Cache) {
+    assert(!builtCFG && !builtCompleteCFG && "CFG already built");
+    SharedCFGs = Cache;
+  }
+  CFGCache *getCFGCache() const { return SharedCFGs; }
+
   void registerForcedBlockExpression(const Stmt *stmt);
   const CFGBlock *getBlockForRegisteredExpression(const Stmt *stmt);
 
@@ -420,6 +510,9 @@ class AnalysisDeclContextManager {
   /// for well-known functions.
   bool SynthesizeBodies;
 
+  /// The CFG cache handed to the contexts this manager creates, if any.
+  CFGCache *SharedCFGs;
+
 public:
   AnalysisDeclContextManager(bool useUnoptimizedCFG = false,
                              bool addImplicitDtors = false,
@@ -441,6 +534,10 @@ public:
   CFG::BuildOptions &getCFGBuildOptions() {
     return cfgBuildOptions;
   }
+
+  /// Share the CFGs of the contexts created from now on through \p Cache.
+  void setCFGCache(CFGCache *Cache) { SharedCFGs = Cache; }
+  CFGCache *getCFGCache() const { return SharedCFGs; }
   
   /// Return true if faux bodies should be synthesized for well-known
   /// functions.
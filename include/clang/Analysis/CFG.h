@@ -753,6 +753,33 @@ public:
       return *this;
     }
 
+    /// Returns true if a CFG built with these options depends only on the
+    /// options themselves, and so may be shared with other clients that use
+    /// the same options. This is not the case when blocks are forced for
+    /// specific expressions or an observer is notified during construction.
+    ///
+    /// AnalysisDeclContext always points \c forcedBlkExprs at its own,
+    /// usually empty, map, so only a non-empty map makes a CFG unshareable.
+    bool isShareable() const {
+      return (!forcedBlkExprs || !*forcedBlkExprs ||
+              (*forcedBlkExprs)->empty()) &&
+             !Observer;
+    }
+
+    /// Returns true if these options build the same CFG as \p Other.
+    bool buildsSameCFGAs(const BuildOptions &Other) const {
+      return alwaysAddMask == Other.alwaysAddMask &&
+             PruneTriviallyFalseEdges == Other.PruneTriviallyFalseEdges &&
+             AddEHEdges == Other.AddEHEdges &&
+             AddInitializers == Other.AddInitializers &&
+             AddImplicitDtors == Other.AddImplicitDtors &&
+             AddTemporaryDtors == Other.AddTemporaryDtors &&
+             AddStaticInitBranches == Other.AddStaticInitBranches &&
+             AddCXXNewAllocator == Other.AddCXXNewAllocator &&
+             AddCXXDefaultInitExprInCtors ==
+                 Other.AddCXXDefaultInitExprInCtors;
+    }
+
     BuildOptions()
       : forcedBlkExprs(nullptr), Observer(nullptr),
         PruneTriviallyFalseEdges(true), AddEHEdges(false),
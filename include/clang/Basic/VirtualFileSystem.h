@@ -359,6 +359,90 @@ public:
   void write(llvm::raw_ostream &OS);
 };
 
+/// \brief Gets a read-only \p FileSystem for a snapshot written by
+/// \p SnapshotVFSWriter.
+///
+/// \p Buffer should be a memory-mapped snapshot file. Lookups hash the
+/// normalized path and probe the snapshot's hash table in place; nothing is
+/// copied up front. The contents of each file are returned as a
+/// \p MemoryBuffer that points into \p Buffer, which the returned file system
+/// keeps alive.
+///
+/// The snapshot is validated once, here, before any lookup: the header must
+/// carry the expected magic number and version, the hash table, entry table,
+/// string table and contents must lie within \p Buffer, every hash table slot
+/// must name an entry in the entry table, every entry's name must lie within
+/// the string table, every file's contents (including the trailing null
+/// byte) must lie within the contents area, and every directory's range of
+/// children must lie within the entry table. Lookups therefore never read
+/// outside \p Buffer, even for a truncated or corrupted file. Validation is
+/// linear in the number of entries and reads none of the file contents.
+///
+/// \returns null, and sets \p Error, if \p Buffer is not a valid snapshot.
+IntrusiveRefCntPtr<FileSystem>
+getVFSFromSnapshot(std::unique_ptr<llvm::MemoryBuffer> Buffer,
+                   std::string &Error);
+
+/// \brief Writes a directory tree and the contents of its files as a
+/// single, memory-mappable snapshot.
+///
+/// A snapshot consists of:
+///   - a header with a magic number, version and table sizes;
+///   - an open-addressing hash table mapping the hash of each normalized
+///     absolute path to its entry;
+///   - one fixed-size entry per file or directory, holding its kind, size,
+///     modification time and name, and either the offset of its contents or
+///     the range of its children in the entry table;
+///   - the string table of names;
+///   - the contents of the files, each aligned to 8 bytes and followed by a
+///     null byte, so they can be handed out as null-terminated buffers
+///     without copying.
+///
+/// Directories are created for every prefix of the paths added. All integers
+/// are little-endian.
+class SnapshotVFSWriter {
+  struct FileEntry {
+    std::string VPath;
+    std::string RPath;
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+    time_t ModificationTime;
+  };
+  std::vector<FileEntry> Files;
+  bool IsCaseSensitive;
+
+public:
+  SnapshotVFSWriter() : IsCaseSensitive(true) {}
+
+  /// \brief Add the file at \p RealPath, which is read when the snapshot is
+  /// written, as \p VirtualPath.
+  void addFileMapping(StringRef VirtualPath, StringRef RealPath) {
+    FileEntry E;
+    E.VPath = VirtualPath;
+    E.RPath = RealPath;
+    E.ModificationTime = 0;
+    Files.push_back(std::move(E));
+  }
+
+  /// \brief Add a file with the given contents as \p VirtualPath.
+  void addFile(StringRef VirtualPath, time_t ModificationTime,
+               std::unique_ptr<llvm::MemoryBuffer> Buffer) {
+    FileEntry E;
+    E.VPath = VirtualPath;
+    E.Buffer = std::move(Buffer);
+    E.ModificationTime = ModificationTime;
+    Files.push_back(std::move(E));
+  }
+
+  void setCaseSensitivity(bool CaseSensitive) {
+    IsCaseSensitive = CaseSensitive;
+  }
+
+  /// \brief Write the snapshot.
+  ///
+  /// \returns an error if one of the mapped files could not be read.
+  std::error_code write(llvm::raw_ostream &OS);
+};
+
 } // end namespace vfs
 } // end namespace clang
 #endif
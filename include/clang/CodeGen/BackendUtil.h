@@ -11,7 +11,16 @@
 #define LLVM_CLANG_CODEGEN_BACKENDUTIL_H
 
 #include "clang/Basic/LLVM.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetOptions.h"
+#include "clang/Frontend/CodeGenOptions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
+#include "llvm/Support/raw_ostream.h"
 #include <memory>
 
 namespace llvm {
@@ -42,6 +51,85 @@ namespace clang {
 
   void EmbedBitcode(llvm::Module *M, const CodeGenOptions &CGOpts,
                     llvm::MemoryBufferRef Buf);
+
+  /// \brief Everything the backend needs to emit one module, independent of
+  /// the frontend that produced it.
+  struct BackendJob {
+    /// \brief The context of \p M. The job must be its only user, since the
+    /// backend runs on another thread.
+    std::unique_ptr<llvm::LLVMContext> Context;
+    std::unique_ptr<llvm::Module> M;
+    CodeGenOptions CGOpts;
+    TargetOptions TOpts;
+    LangOptions LOpts;
+    BackendAction Action;
+    std::unique_ptr<raw_pwrite_stream> OS;
+
+    /// \brief The source manager of the translation unit, kept alive until
+    /// the job's diagnostics are reported.
+    ///
+    /// Inline assembly diagnostics carry the raw encoding of the location of
+    /// the asm statement, and optimization remarks carry debug locations;
+    /// \c BackendThread::wait() maps both through this source manager, on
+    /// the calling thread, as \c BackendConsumer would.
+    IntrusiveRefCntPtr<SourceManager> SourceMgr;
+
+    /// \brief What diagnostics about a function need to know of its
+    /// declaration.
+    struct FunctionInfo {
+      SourceLocation Loc;
+      std::string QualifiedName;
+    };
+
+    /// \brief The functions defined in \p M, by mangled name, filled from
+    /// the CodeGenModule when the job is created.
+    ///
+    /// Diagnostics that name a function (e.g. frame size warnings) are
+    /// reported at its declaration under its source name, which
+    /// \c BackendConsumer otherwise finds through the CodeGenModule.
+    llvm::StringMap<FunctionInfo> Functions;
+
+    BackendJob() : Action(Backend_EmitNothing) {}
+  };
+
+  /// \brief Runs \c EmitBackendOutput() on a background thread, so that a
+  /// tool compiling a batch of translation units in one process overlaps
+  /// the optimization and code generation of one with the frontend work of
+  /// the next.
+  ///
+  /// Jobs are processed one at a time, in the order they were queued. The
+  /// diagnostics the backend produces are buffered, unmapped, and reported
+  /// by \c wait(), in queue order, so the output does not depend on timing.
+  /// Their locations are mapped through the job's \c SourceMgr and
+  /// \c Functions, so they read the same as when the backend runs in the
+  /// frontend.
+  class BackendThread {
+  public:
+    /// \param MaxPendingJobs The number of jobs that may wait in the queue;
+    /// \c enqueue() blocks while the queue is full, which bounds the memory
+    /// held by modules waiting for the backend.
+    explicit BackendThread(unsigned MaxPendingJobs = 1);
+
+    /// \brief Waits for the queued jobs to finish. Diagnostics not yet
+    /// reported through \c wait() are dropped.
+    ~BackendThread();
+
+    BackendThread(const BackendThread &) = delete;
+    void operator=(const BackendThread &) = delete;
+
+    /// \brief Queue a job, starting the thread on first use.
+    void enqueue(BackendJob Job);
+
+    /// \brief Wait for every queued job to finish and report their
+    /// diagnostics to \p Diags.
+    ///
+    /// \returns true if any job produced an error.
+    bool wait(DiagnosticsEngine &Diags);
+
+  private:
+    struct Implementation;
+    std::unique_ptr<Implementation> Impl;
+  };
 }
 
 #endif
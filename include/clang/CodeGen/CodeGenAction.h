@@ -20,6 +20,7 @@ namespace llvm {
 
 namespace clang {
 class BackendConsumer;
+class BackendThread;
 
 class CodeGenAction : public ASTFrontendAction {
 private:
@@ -31,6 +32,10 @@ private:
   llvm::LLVMContext *VMContext;
   bool OwnsVMContext;
 
+  /// The thread to hand the module to for code generation, or null to run
+  /// the backend in the action.
+  BackendThread *AsyncBackend;
+
 protected:
   /// Create a new code generation action.  If the optional \p _VMContext
   /// parameter is supplied, the action uses it without taking ownership,
@@ -63,6 +68,16 @@ public:
   /// Take the LLVM context used by this action.
   llvm::LLVMContext *takeLLVMContext();
 
+  /// Run the backend for this action on \p BT instead of in the action.
+  ///
+  /// This only takes effect if the action owns its LLVM context: the module,
+  /// the context and the output stream are then moved into a \c BackendJob,
+  /// together with the source manager and the function declarations that
+  /// backend diagnostics are mapped through, when the translation unit is
+  /// complete, and the action returns without waiting for code generation.
+  /// The caller collects the results with \c BackendThread::wait().
+  void setBackendThread(BackendThread *BT) { AsyncBackend = BT; }
+
   BackendConsumer *BEConsumer;
 };
 
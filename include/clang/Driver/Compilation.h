@@ -89,6 +89,17 @@ class Compilation {
   /// Whether we're compiling for diagnostic purposes.
   bool ForDiagnostics;
 
+  /// The maximum number of commands ExecuteJobs runs at once. 1 runs the
+  /// jobs one after another, as before.
+  unsigned MaxParallelJobs;
+
+  /// ExecuteJobsInParallel - Run \p Jobs on up to MaxParallelJobs processes.
+  /// Every job is spawned as a process, including CC1Commands, which would
+  /// otherwise run in-process, since the frontend is not reentrant.
+  void ExecuteJobsInParallel(
+      const JobList &Jobs,
+      SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands) const;
+
 public:
   Compilation(const Driver &D, const ToolChain &DefaultToolChain,
               llvm::opt::InputArgList *Args,
@@ -234,8 +245,21 @@ public:
 
   /// ExecuteJob - Execute a single job.
   ///
+  /// When more than one parallel job is allowed, independent commands are
+  /// started as soon as a process slot is free, and a command only starts
+  /// once the commands producing its inputs have succeeded. The output of
+  /// each command is buffered and written in job order.
+  ///
+  /// As in a sequential run, execution stops at the first failing command
+  /// in job order: once a command fails, no new command is started, and the
+  /// commands after it that are already running are waited for, their
+  /// output and results discarded and their output files removed. Commands
+  /// before it still finish, and if one of them fails it becomes the first
+  /// failure instead. The output, the exit code and \p FailingCommands are
+  /// therefore the same as for a sequential run.
+  ///
   /// \param FailingCommands - For non-zero results, this will be a vector of
-  /// failing commands and their associated result code.
+  /// failing commands and their associated result code, in job order.
   void ExecuteJobs(
       const JobList &Jobs,
       SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands) const;
@@ -248,6 +272,17 @@ public:
   /// Return true if we're compiling for diagnostics.
   bool isForDiagnostics() const { return ForDiagnostics; }
 
+  /// getMaxParallelJobs - Return the maximum number of commands to run at
+  /// once.
+  unsigned getMaxParallelJobs() const { return MaxParallelJobs; }
+
+  /// setMaxParallelJobs - Set the maximum number of commands to run at once;
+  /// 0 means one per hardware thread. Compilations with redirected output,
+  /// or for diagnostics, always run their commands one at a time. With more
+  /// than one, -cc1 jobs are spawned as processes even if the driver has an
+  /// in-process entry point (see CC1Command).
+  void setMaxParallelJobs(unsigned N) { MaxParallelJobs = N; }
+
   /// Redirect - Redirect output of this compilation. Can only be done once.
   ///
   /// \param Redirects - array of pointers to paths. The array
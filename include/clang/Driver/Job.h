@@ -119,6 +119,39 @@ public:
   static void printArg(llvm::raw_ostream &OS, const char *Arg, bool Quote);
 };
 
+/// Like Command, but runs a -cc1 job inside the driver process instead of
+/// spawning a new one.
+///
+/// The job is run by calling \p CC1Main within a CrashRecoveryContext, so
+/// that a crash in the frontend is reported as a failure of this command, as
+/// it would be for a child process, rather than taking down the driver.
+/// Redirected output is not supported in-process; such commands are run as a
+/// separate process instead.
+///
+/// The frontend is not reentrant: the llvm::cl option state, the fatal error
+/// handler and the memory deliberately leaked under -disable-free are
+/// process-wide. At most one CC1Command therefore runs in-process at a time,
+/// and only when the compilation runs its jobs one at a time. When
+/// Compilation runs jobs in parallel (see Compilation::getMaxParallelJobs()),
+/// it runs every CC1Command as a separate process, through
+/// Command::Execute().
+class CC1Command : public Command {
+public:
+  /// The signature of the entry point used to run -cc1 in-process. \p Argv
+  /// holds the executable followed by the arguments, starting with "-cc1".
+  typedef int (*CC1MainFn)(ArrayRef<const char *> Argv);
+
+  CC1Command(const Action &Source_, const Tool &Creator_,
+             const char *Executable_, const ArgStringList &Arguments_,
+             ArrayRef<InputInfo> Inputs, CC1MainFn CC1Main);
+
+  int Execute(const StringRef **Redirects, std::string *ErrMsg,
+              bool *ExecutionFailed) const override;
+
+private:
+  CC1MainFn CC1Main;
+};
+
 /// Like Command, but with a fallback which is executed in case
 /// the primary command crashes.
 class FallbackCommand : public Command {
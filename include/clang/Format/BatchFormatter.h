@@ -0,0 +1,101 @@
+//===--- BatchFormatter.h - Format many files concurrently ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Declares BatchFormatter, which formats a list of files on a thread
+/// pool and reports the files whose formatting would change.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_FORMAT_BATCHFORMATTER_H
+#define LLVM_CLANG_FORMAT_BATCHFORMATTER_H
+
+#include "clang/Format/Format.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Mutex.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace format {
+
+/// \brief Options controlling a \c BatchFormatter.
+struct BatchFormatOptions {
+  /// \brief The style name passed to \c getStyle() for every file, e.g.
+  /// "file" to search for a .clang-format file.
+  std::string StyleName;
+
+  /// \brief The style used for files without a .clang-format file.
+  std::string FallbackStyle;
+
+  /// \brief Whether to sort includes before reformatting.
+  bool SortIncludes;
+
+  /// \brief The number of worker threads, or 0 to use one per hardware
+  /// thread.
+  unsigned NumThreads;
+
+  BatchFormatOptions()
+      : StyleName("file"), FallbackStyle("LLVM"), SortIncludes(true),
+        NumThreads(0) {}
+};
+
+/// \brief The outcome of formatting one file in a batch.
+struct BatchFormatResult {
+  /// \brief The name of the file, as given to \c BatchFormatter::format().
+  std::string FileName;
+
+  /// \brief The replacements that format the file. Empty if the file was
+  /// already formatted or could not be read.
+  tooling::Replacements Replaces;
+
+  /// \brief A description of the error, if the file could not be read.
+  std::string Error;
+};
+
+/// \brief Formats many files concurrently.
+///
+/// Each file is mapped into memory rather than copied, formatted on a worker
+/// thread, and discarded. The style of a file is computed once per directory
+/// and shared by every file in that directory, so .clang-format files are
+/// located and parsed once rather than once per file.
+///
+/// Only the files whose contents would change, or that could not be read,
+/// are reported. Results are returned in the order the files were given, so
+/// the output does not depend on the number of threads.
+class BatchFormatter {
+public:
+  explicit BatchFormatter(BatchFormatOptions Opts) : Opts(std::move(Opts)) {}
+
+  BatchFormatter(const BatchFormatter &) = delete;
+  void operator=(const BatchFormatter &) = delete;
+
+  /// \brief Format the given files, returning one result for each file that
+  /// needs changes or could not be read.
+  std::vector<BatchFormatResult> format(ArrayRef<std::string> Files);
+
+  /// \brief Retrieve the style that applies to files in the directory
+  /// containing \p FileName, computing it if needed.
+  ///
+  /// May be called concurrently from the worker threads.
+  FormatStyle getStyleForFile(StringRef FileName);
+
+private:
+  BatchFormatOptions Opts;
+
+  /// \brief The style of each directory seen so far, keyed by directory and
+  /// language, since a .clang-format file may give one style per language.
+  llvm::StringMap<FormatStyle> StyleCache;
+  llvm::sys::Mutex StyleCacheLock;
+};
+
+} // end namespace format
+} // end namespace clang
+
+#endif
@@ -18,6 +18,7 @@
 #include "clang/Basic/LangOptions.h"
 #include "clang/Tooling/Core/Replacement.h"
 #include "llvm/ADT/ArrayRef.h"
+#include <memory>
 #include <system_error>
 
 namespace clang {
@@ -810,6 +811,70 @@ tooling::Replacements reformat(const FormatStyle &Style, StringRef Code,
                                StringRef FileName = "<stdin>",
                                bool *IncompleteFormat = nullptr);
 
+/// \brief Reformats successive versions of one file, reusing the work done
+/// for the previous version.
+///
+/// The formatter keeps the tokens and unwrapped lines of the last version it
+/// was given. On the next call, the region that differs from that version is
+/// found by comparing the common prefix and suffix of the two versions, or
+/// taken from the edits reported through \c noteEdit(). Lines before that
+/// region are reused as they are. Parsing restarts at the first unwrapped
+/// line that overlaps the region and continues past its end until it
+/// reaches a line boundary where the parser state equals the one cached for
+/// that boundary: the same nesting level and enclosing blocks, the same
+/// preprocessor branch state, and no open group of lines aligned by the
+/// \c AlignConsecutive* options that spans the boundary. From there on, the
+/// cached lines are shifted to their new offsets and reused. An edit that
+/// changes, e.g., the nesting of the rest of the file is thus re-parsed to
+/// the end. Layout is redone for the re-parsed lines and for the lines that
+/// intersect the requested \p Ranges.
+///
+/// With these rules the results are identical to calling \c reformat() on
+/// each version. Calling \c reformat() again with the same code and ranges
+/// as the previous call re-parses nothing and returns the same replacements
+/// as that call. An instance is not safe to use from several threads at
+/// once.
+class IncrementalFormatter {
+public:
+  IncrementalFormatter(const FormatStyle &Style,
+                       StringRef FileName = "<stdin>");
+  ~IncrementalFormatter();
+
+  /// \brief Reformats the given \p Ranges in \p Code, which is the new
+  /// version of the file.
+  ///
+  /// Otherwise identical to the reformat() function using a code string.
+  tooling::Replacements reformat(StringRef Code,
+                                 ArrayRef<tooling::Range> Ranges,
+                                 bool *IncompleteFormat = nullptr);
+
+  /// \brief Reports that, since the version last passed to \c reformat(),
+  /// \p RemovedLength bytes at \p Offset were replaced by \p InsertedLength
+  /// bytes.
+  ///
+  /// Editors that know their edits can report them to avoid the prefix and
+  /// suffix comparison on the next call.
+  void noteEdit(unsigned Offset, unsigned RemovedLength,
+                unsigned InsertedLength);
+
+  /// \brief Drops all cached state, so that the next call formats the file
+  /// from scratch.
+  void reset();
+
+  /// \brief Statistics about the last call to \c reformat().
+  struct Stats {
+    /// The number of unwrapped lines reused from the previous version.
+    unsigned ReusedLines;
+    /// The number of unwrapped lines that were parsed again.
+    unsigned ReparsedLines;
+  };
+  Stats getLastStats() const;
+
+private:
+  class Implementation;
+  std::unique_ptr<Implementation> Impl;
+};
+
 /// \brief Clean up any erroneous/redundant code in the given \p Ranges in the
 /// file \p ID.
 ///
@@ -58,6 +58,7 @@ class HeaderSearch;
 class Preprocessor;
 class PCHContainerOperations;
 class PCHContainerReader;
+class PreambleCache;
 class SourceManager;
 class TargetInfo;
 class FrontendAction;
@@ -293,6 +294,26 @@ private:
   /// declarations parsed within the precompiled preamble.
   std::vector<serialization::DeclID> TopLevelDeclsInPreamble;
   
+  /// \brief The cache through which this unit shares its precompiled
+  /// preamble with other units, or null if the preamble is private.
+  IntrusiveRefCntPtr<PreambleCache> SharedPreambles;
+
+  /// \brief The key of the shared preamble this unit currently uses, or
+  /// empty if it uses a private one.
+  std::string SharedPreambleKey;
+
+  /// \brief State of a preamble being built on a background thread.
+  struct BackgroundPreambleBuild;
+
+  /// \brief The preamble build in flight, if any.
+  ///
+  /// \see setBuildPreambleInBackground
+  std::unique_ptr<BackgroundPreambleBuild> PendingPreamble;
+
+  /// \brief Whether to build the precompiled preamble on a background
+  /// thread rather than during reparse.
+  bool BuildPreambleInBackground : 1;
+
   /// \brief Whether we should be caching code-completion results.
   bool ShouldCacheCodeCompletionResults : 1;
 
@@ -450,6 +471,20 @@ private:
       unsigned MaxLines = 0);
   void RealizeTopLevelDeclsFromPreamble();
 
+  /// \brief Start building a preamble for the given invocation on a
+  /// background thread, unless a build for the same preamble is already in
+  /// flight.
+  void startBackgroundPreambleBuild(
+      std::shared_ptr<PCHContainerOperations> PCHContainerOps,
+      const CompilerInvocation &PreambleInvocation,
+      ComputedPreamble &NewPreamble);
+
+  /// \brief If a background preamble build has finished, replace the
+  /// current preamble with its result.
+  ///
+  /// \returns true if a new preamble was adopted.
+  bool adoptBackgroundPreamble();
+
   /// \brief Transfers ownership of the objects (like SourceManager) from
   /// \param CI to this ASTUnit.
   void transferASTDataFromCompilerInstance(CompilerInstance &CI);
@@ -493,6 +528,27 @@ public:
 
   bool isMainFileAST() const { return MainFileIsAST; }
 
+  /// \brief Share this unit's precompiled preamble with every other unit
+  /// using the same cache, when their preambles and flags match.
+  void setPreambleCache(IntrusiveRefCntPtr<PreambleCache> Cache);
+
+  /// \brief Build precompiled preambles on a background thread.
+  ///
+  /// When a reparse finds the preamble out of date, it starts the build and
+  /// returns at once, keeping the old AST. Reparses requested while the
+  /// build runs also keep the old AST; they neither wait for the build nor
+  /// parse without a preamble. The first reparse after the build finishes
+  /// adopts the new preamble and parses the main file against it.
+  void setBuildPreambleInBackground(bool Value) {
+    BuildPreambleInBackground = Value;
+  }
+
+  /// \brief Whether a precompiled preamble is being built in the background.
+  bool isBuildingPreamble() const;
+
+  /// \brief Block until the background preamble build, if any, finishes.
+  void waitForBackgroundPreamble();
+
   bool isUnsafeToFree() const { return UnsafeToFree; }
   void setUnsafeToFree(bool Value) { UnsafeToFree = Value; }
 
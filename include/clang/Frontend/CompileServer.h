@@ -0,0 +1,165 @@
+//===--- CompileServer.h - Persistent compilation server --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the CompileServer class, which serves -cc1 requests over
+// a Unix domain socket while keeping file system and module state warm across
+// requests, and the ModuleFileCache class, which holds that module state.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_FRONTEND_COMPILESERVER_H
+#define LLVM_CLANG_FRONTEND_COMPILESERVER_H
+
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace clang {
+
+class ASTReader;
+
+/// \brief The module files and precompiled headers loaded by previous
+/// compilations, kept in memory for later ones.
+///
+/// Each entry remembers the size, modification time and content hash the
+/// file had when it was loaded. An entry is reused only if the file on disk
+/// has the same size and modification time, or, when only the modification
+/// time differs, the same content hash; otherwise it is dropped and the file
+/// is read again.
+class ModuleFileCache : public llvm::ThreadSafeRefCountedBase<ModuleFileCache> {
+public:
+  struct Entry {
+    std::unique_ptr<llvm::MemoryBuffer> Buffer;
+    off_t Size;
+    time_t ModTime;
+    uint64_t Hash;
+  };
+
+private:
+  mutable llvm::sys::Mutex Lock;
+  llvm::StringMap<Entry> Entries;
+  std::atomic<unsigned> NumHits;
+  std::atomic<unsigned> NumMisses;
+
+public:
+  ModuleFileCache() : NumHits(0), NumMisses(0) {}
+
+  /// \brief Make every cached module file that is still valid available to
+  /// the given reader, without copying it.
+  ///
+  /// \returns the number of files made available.
+  unsigned addValidBuffersTo(ASTReader &Reader, FileManager &FileMgr);
+
+  /// \brief Remember the module files the given reader loaded from disk.
+  void retainBuffersFrom(ASTReader &Reader);
+
+  /// \brief Drop every entry.
+  void clear() {
+    llvm::MutexGuard Guard(Lock);
+    Entries.clear();
+  }
+
+  unsigned getNumHits() const { return NumHits; }
+  unsigned getNumMisses() const { return NumMisses; }
+};
+
+/// \brief A local server that runs -cc1 jobs for clients, keeping a warm
+/// FileManager and ModuleFileCache between them.
+///
+/// Requests are served one at a time. Before each one, the FileManager is
+/// checked against the file system: if any file it has seen changed size or
+/// modification time, or a file it found missing now exists, it is replaced
+/// by a fresh one. Each request otherwise runs exactly as the same -cc1
+/// command line would in a new process.
+class CompileServer {
+public:
+  struct Options {
+    /// \brief The path of the Unix domain socket to listen on.
+    std::string SocketPath;
+
+    /// \brief The number of seconds without a request after which the server
+    /// exits, or 0 to never time out.
+    unsigned IdleTimeout;
+
+    Options() : IdleTimeout(0) {}
+  };
+
+  struct Stats {
+    /// \brief The number of requests served.
+    unsigned Requests;
+
+    /// \brief The number of requests that reused the warm FileManager.
+    unsigned FileManagerReuses;
+
+    Stats() : Requests(0), FileManagerReuses(0) {}
+  };
+
+private:
+  Options Opts;
+  FileSystemOptions FileSystemOpts;
+  IntrusiveRefCntPtr<FileManager> Files;
+  IntrusiveRefCntPtr<ModuleFileCache> ModuleFiles;
+  Stats ServerStats;
+  std::atomic<bool> ShutdownRequested;
+
+  /// \brief Return a FileManager for the next request, reusing the warm one
+  /// if nothing it has cached has changed.
+  FileManager &getValidatedFileManager();
+
+public:
+  explicit CompileServer(Options Opts);
+  ~CompileServer();
+
+  CompileServer(const CompileServer &) = delete;
+  void operator=(const CompileServer &) = delete;
+
+  /// \brief Listen on the socket and serve requests until \c shutdown() is
+  /// called or the idle timeout expires.
+  ///
+  /// \returns false, and sets \p Error, if the socket could not be created.
+  bool serve(std::string &Error);
+
+  /// \brief Ask \c serve() to return after the current request.
+  void shutdown() { ShutdownRequested = true; }
+
+  /// \brief Run one -cc1 command line with the server's warm state.
+  ///
+  /// This is what \c serve() does for each request; it can be called
+  /// directly to drive the server without a socket.
+  ///
+  /// \param Argv The arguments, starting with "-cc1".
+  /// \param WorkingDir The directory relative paths are resolved against.
+  /// \param Output Receives the diagnostics the command produced.
+  /// \returns the command's exit code.
+  int handleRequest(ArrayRef<const char *> Argv, StringRef WorkingDir,
+                    std::string &Output);
+
+  /// \brief Send one request to the server listening on \p SocketPath and
+  /// wait for its result.
+  ///
+  /// \returns false, and sets \p Error, if no server answered.
+  static bool sendRequest(StringRef SocketPath, ArrayRef<const char *> Argv,
+                          StringRef WorkingDir, int &Result,
+                          std::string &Output, std::string &Error);
+
+  const Stats &getStats() const { return ServerStats; }
+  const ModuleFileCache &getModuleFileCache() const { return *ModuleFiles; }
+};
+
+} // end namespace clang
+
+#endif
@@ -45,6 +45,7 @@ class FileEntry;
 class FileManager;
 class FrontendAction;
 class Module;
+class ModuleFileCache;
 class Preprocessor;
 class Sema;
 class SourceManager;
@@ -114,6 +115,9 @@ class CompilerInstance : public ModuleLoader {
   /// \brief The ASTReader, if one exists.
   IntrusiveRefCntPtr<ASTReader> ModuleManager;
 
+  /// \brief Module files kept in memory across compiler instances, if any.
+  IntrusiveRefCntPtr<ModuleFileCache> ModuleFiles;
+
   /// \brief The module dependency collector for crashdumps
   std::shared_ptr<ModuleDependencyCollector> ModuleDepCollector;
 
@@ -500,6 +504,15 @@ public:
   IntrusiveRefCntPtr<ASTReader> getModuleManager() const;
   void setModuleManager(IntrusiveRefCntPtr<ASTReader> Reader);
 
+  /// \brief Share module files with other compiler instances through the
+  /// given cache.
+  ///
+  /// The valid cached files are handed to the module manager when it is
+  /// created, and the files it loads from disk are added to the cache when
+  /// this instance is cleared.
+  void setModuleFileCache(IntrusiveRefCntPtr<ModuleFileCache> Cache);
+  ModuleFileCache *getModuleFileCache() const { return ModuleFiles.get(); }
+
   std::shared_ptr<ModuleDependencyCollector> getModuleDepCollector() const;
   void setModuleDepCollector(
       std::shared_ptr<ModuleDependencyCollector> Collector);
@@ -264,6 +264,10 @@ public:
   /// (in the format produced by -fdump-record-layouts).
   std::string OverrideRecordLayoutsFile;
 
+  /// \brief If non-empty, profile template instantiation and write the
+  /// per-template and per-caller report to this file as JSON.
+  std::string TemplateInstantiationProfileFile;
+
   /// \brief Auxiliary triple for CUDA compilation.
   std::string AuxTriple;
 
@@ -0,0 +1,181 @@
+//===--- PreambleCache.h - Preambles shared between ASTUnits ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the PreambleCache class, which lets translation units
+// that share the same include prefix and compiler flags share one
+// precompiled preamble.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_FRONTEND_PREAMBLECACHE_H
+#define LLVM_CLANG_FRONTEND_PREAMBLECACHE_H
+
+#include "clang/Frontend/ASTUnit.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/MutexGuard.h"
+#include "llvm/Support/Path.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+
+class CompilerInvocation;
+
+/// \brief A process-wide cache of precompiled preambles, keyed by a hash of
+/// the preamble's contents, of the compiler invocation that built it and of
+/// the main file's directory.
+///
+/// Two translation units in the same directory whose main files start with
+/// the same \#include block and are compiled with the same flags find the
+/// same entry, and load the same PCH instead of each building a private one.
+///
+/// The key does not cover the contents of the headers in the preamble, so
+/// a preamble rebuilt after a header changed has the same key as the stale
+/// one. The unit that notices the change (through \c FilesInPreamble)
+/// invalidates the key and publishes a new entry under it. Each PCH file is
+/// therefore named after the hash of its own contents rather than the key:
+/// the rebuilt PCH goes to a new file, and units that still have the old
+/// one mapped are unaffected. Entries and PCH files are never modified once
+/// published.
+///
+/// All member functions may be called concurrently.
+class PreambleCache : public llvm::ThreadSafeRefCountedBase<PreambleCache> {
+public:
+  /// \brief A precompiled preamble and the state an ASTUnit needs to adopt
+  /// it.
+  ///
+  /// Nothing in an entry refers to the FileManager or the main file of the
+  /// unit that built it.
+  struct Entry : public llvm::ThreadSafeRefCountedBase<Entry> {
+    /// \brief The path of the precompiled preamble, as returned by
+    /// \c getPCHPath() for the hash of the PCH's contents.
+    std::string PCHFile;
+
+    /// \brief The bytes of the main file that the preamble covers.
+    ///
+    /// An adopting unit assigns them to its own \c ASTUnit::PreambleData,
+    /// together with the \c FileEntry of its own main file.
+    std::vector<char> PreambleBytes;
+
+    /// \brief Whether the preamble ends at the start of a new line.
+    bool PreambleEndsAtStartOfLine;
+
+    /// \brief The files used when computing the preamble, and their hashes.
+    ///
+    /// An entry is only reused if every one of these files is unchanged.
+    llvm::StringMap<ASTUnit::PreambleFileHash> FilesInPreamble;
+
+    /// \brief The diagnostics produced while building the preamble.
+    ///
+    /// Diagnostics located in the main file are stored with an empty
+    /// \c Filename; an adopting unit attributes them to its own main file.
+    /// The others name headers, which are the same for every unit sharing
+    /// the key.
+    SmallVector<ASTUnit::StandaloneDiagnostic, 4> Diagnostics;
+
+    /// \brief The number of warnings produced while building the preamble.
+    unsigned NumWarnings;
+
+    /// \brief The serialization IDs of the top-level declarations in the
+    /// preamble.
+    std::vector<serialization::DeclID> TopLevelDecls;
+
+    /// \brief The hash of the top-level declaration and macro names in the
+    /// preamble, used to decide when to refresh cached completion results.
+    unsigned TopLevelHashValue;
+
+    Entry()
+        : PreambleEndsAtStartOfLine(false), NumWarnings(0),
+          TopLevelHashValue(0) {}
+  };
+
+private:
+  std::string Directory;
+  mutable llvm::sys::Mutex Lock;
+  llvm::StringMap<IntrusiveRefCntPtr<Entry>> Entries;
+
+public:
+  /// \brief Create a cache that stores its precompiled preambles in the
+  /// given directory, which must already exist.
+  explicit PreambleCache(StringRef Directory) : Directory(Directory) {}
+
+  /// \brief Compute the cache key for a preamble with the given contents,
+  /// built by the given invocation for the given main file.
+  ///
+  /// The key covers the preamble bytes, every option that affects the
+  /// serialized AST (language, target, preprocessor and header search
+  /// options) and the directory of \p MainFilePath, against which quoted
+  /// \#includes are resolved. It does not cover the main file's name or
+  /// the parts of the invocation that only affect code generation; a
+  /// preamble that expands \c __BASE_FILE__ depends on the name, so it is
+  /// kept private to the unit that built it and never inserted.
+  static std::string getKey(const CompilerInvocation &Invocation,
+                            StringRef MainFilePath,
+                            StringRef PreambleContents);
+
+  /// \brief Retrieve the directory in which preambles are stored.
+  StringRef getDirectory() const { return Directory; }
+
+  /// \brief Retrieve the path under which a built precompiled preamble is
+  /// stored, given the hash of its contents.
+  ///
+  /// The builder writes the PCH to a temporary file, hashes it and renames
+  /// it to this path before publishing the entry; if the path already
+  /// exists, the existing file has the same contents and is used instead.
+  std::string getPCHPath(StringRef PCHHash) const {
+    SmallString<128> Path(Directory);
+    llvm::sys::path::append(Path, "preamble-" + PCHHash + ".pch");
+    return Path.str();
+  }
+
+  /// \brief Look for a preamble with the given key.
+  ///
+  /// \returns the entry, or null if no translation unit has built a preamble
+  /// with this key yet. The caller is responsible for checking the entry's
+  /// \c FilesInPreamble against the current file system.
+  IntrusiveRefCntPtr<Entry> lookup(StringRef Key) const {
+    llvm::MutexGuard Guard(Lock);
+    auto Known = Entries.find(Key);
+    if (Known == Entries.end())
+      return nullptr;
+    return Known->second;
+  }
+
+  /// \brief Publish a newly built preamble under the given key.
+  ///
+  /// \returns the entry that is now cached under \p Key, which is the
+  /// existing entry if another translation unit published one first.
+  IntrusiveRefCntPtr<Entry> insert(StringRef Key,
+                                   IntrusiveRefCntPtr<Entry> NewEntry) {
+    llvm::MutexGuard Guard(Lock);
+    IntrusiveRefCntPtr<Entry> &Slot = Entries[Key];
+    if (!Slot)
+      Slot = std::move(NewEntry);
+    return Slot;
+  }
+
+  /// \brief Drop the entry with the given key, e.g., because one of the files
+  /// it depends on has changed, so that a rebuilt preamble can be inserted
+  /// under the same key.
+  ///
+  /// Translation units that already adopted the entry keep it alive. The
+  /// PCH file itself is left in the cache directory, whose owner is
+  /// responsible for pruning it.
+  void invalidate(StringRef Key) {
+    llvm::MutexGuard Guard(Lock);
+    Entries.erase(Key);
+  }
+};
+
+} // namespace clang
+
+#endif
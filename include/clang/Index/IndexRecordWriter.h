@@ -0,0 +1,211 @@
+//===--- IndexRecordWriter.h - Compact on-disk index records ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_INDEX_INDEXRECORDWRITER_H
+#define LLVM_CLANG_INDEX_INDEXRECORDWRITER_H
+
+#include "clang/Basic/LLVM.h"
+#include "clang/Basic/SourceLocation.h"
+#include "clang/Index/IndexDataConsumer.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clang {
+  class SourceManager;
+
+namespace index {
+
+/// The on-disk layout of an index record.
+///
+/// An index record holds the symbol occurrences of one source file, as seen
+/// from one translation unit. What a header contains depends on the macros
+/// and \#if configuration of the translation unit that includes it, so
+/// records are named after the hash of their encoded contents rather than of
+/// the file's. An unchanged record is never written twice, and translation
+/// units that see the same occurrences in a header share its record, while
+/// those that configure it differently get records of their own.
+///
+/// All integers are little-endian. The record consists of:
+///   - a \c RecordHeader;
+///   - \c NumSymbols \c SymbolEntry structures, sorted by USR;
+///   - the string table: the USR and name of each symbol, each terminated by
+///     a null character, referenced by \c SymbolEntry::USROffset and
+///     \c SymbolEntry::NameOffset;
+///   - the occurrence stream: \c NumOccurrences occurrences sorted by
+///     offset, each encoded as ULEB128 values (offset delta from the previous
+///     occurrence, symbol index, roles, number of relations) followed by one
+///     (symbol index, roles) ULEB128 pair per relation.
+///
+/// The header and symbol table have fixed-size entries, so a reader can
+/// binary-search symbols by USR directly in the mapped file; only the
+/// occurrence stream needs to be decoded sequentially.
+namespace record {
+
+/// The magic number at the start of every record: "CIDX".
+const uint32_t Magic = 0x58444943;
+
+/// The version of the record layout described above.
+const uint32_t Version = 1;
+
+struct RecordHeader {
+  llvm::support::ulittle32_t Magic;
+  llvm::support::ulittle32_t Version;
+  llvm::support::ulittle32_t NumSymbols;
+  llvm::support::ulittle32_t NumOccurrences;
+  llvm::support::ulittle32_t StringTableSize;
+  llvm::support::ulittle32_t OccurrencesSize;
+};
+
+struct SymbolEntry {
+  llvm::support::ulittle32_t USROffset;
+  uint8_t Kind;
+  uint8_t Lang;
+  llvm::support::ulittle16_t SubKinds;
+  llvm::support::ulittle32_t NameOffset;
+};
+
+} // namespace record
+
+/// Options controlling where and how index records are written.
+struct IndexRecordOptions {
+  /// The directory in which records are stored. It is created if missing.
+  std::string StorePath;
+
+  /// Whether to write records for files in system headers.
+  bool IndexSystemFiles = false;
+};
+
+/// An IndexDataConsumer that writes the occurrences it is given into one
+/// index record per source file.
+///
+/// Occurrences are buffered per FileID, and symbols are uniqued by USR per
+/// file, while the translation unit is indexed. At \c finish(), each file's
+/// record is encoded in memory and named after the hash of the encoding;
+/// records that already exist in the store are not written again, and the
+/// others are written to a temporary file and renamed into place.
+class IndexRecordWriter : public IndexDataConsumer {
+public:
+  explicit IndexRecordWriter(IndexRecordOptions Opts);
+  ~IndexRecordWriter() override;
+
+  void initialize(ASTContext &Ctx) override;
+
+  bool handleDeclOccurence(const Decl *D, SymbolRoleSet Roles,
+                           ArrayRef<SymbolRelation> Relations,
+                           FileID FID, unsigned Offset,
+                           ASTNodeInfo ASTNode) override;
+
+  bool handleMacroOccurence(const IdentifierInfo *Name,
+                            const MacroInfo *MI, SymbolRoleSet Roles,
+                            FileID FID, unsigned Offset) override;
+
+  bool handleModuleOccurence(const ImportDecl *ImportD,
+                             SymbolRoleSet Roles,
+                             FileID FID, unsigned Offset) override;
+
+  void finish() override;
+
+  /// Returns the names of the records that make up the translation unit
+  /// that was indexed, one per file, in the order the files were entered.
+  ArrayRef<std::string> getRecordNames() const { return RecordNames; }
+
+  /// Returns the number of files whose records already existed, with the
+  /// same contents, and were not written again.
+  unsigned getNumSkippedFiles() const { return NumSkippedFiles; }
+
+private:
+  struct FileRecord;
+
+  IndexRecordOptions Opts;
+  ASTContext *Ctx;
+  const SourceManager *SM;
+
+  /// The records being built, by FileID.
+  llvm::DenseMap<FileID, std::unique_ptr<FileRecord>> Files;
+
+  /// USRs computed for declarations, so each one is generated only once.
+  llvm::DenseMap<const Decl *, StringRef> USRCache;
+  llvm::BumpPtrAllocator USRAllocator;
+
+  std::vector<std::string> RecordNames;
+  unsigned NumSkippedFiles;
+
+  /// Returns the record for \p FID, or null if the file is not indexed,
+  /// e.g. because it is a system header and \c IndexSystemFiles is not set.
+  FileRecord *getFileRecord(FileID FID);
+};
+
+/// Read-only access to an index record, mapped into memory.
+class IndexRecordReader {
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+
+  const record::RecordHeader &getHeader() const {
+    return *reinterpret_cast<const record::RecordHeader *>(
+        Buffer->getBufferStart());
+  }
+
+  explicit IndexRecordReader(std::unique_ptr<llvm::MemoryBuffer> Buffer)
+      : Buffer(std::move(Buffer)) {}
+
+public:
+  /// Map the record with the given name from the store.
+  ///
+  /// \returns null, and sets \p Error, if the record is missing or
+  /// malformed.
+  static std::unique_ptr<IndexRecordReader>
+  create(StringRef StorePath, StringRef RecordName, std::string &Error);
+
+  unsigned getNumSymbols() const { return getHeader().NumSymbols; }
+  unsigned getNumOccurrences() const { return getHeader().NumOccurrences; }
+
+  ArrayRef<record::SymbolEntry> getSymbols() const {
+    const char *Start =
+        Buffer->getBufferStart() + sizeof(record::RecordHeader);
+    return llvm::makeArrayRef(
+        reinterpret_cast<const record::SymbolEntry *>(Start), getNumSymbols());
+  }
+
+  /// Returns the USR of the given symbol.
+  StringRef getUSR(const record::SymbolEntry &Sym) const {
+    return StringRef(getStringTable() + Sym.USROffset);
+  }
+
+  /// Returns the name of the given symbol.
+  StringRef getName(const record::SymbolEntry &Sym) const {
+    return StringRef(getStringTable() + Sym.NameOffset);
+  }
+
+  /// Returns the index of the symbol with the given USR, or -1.
+  int findSymbol(StringRef USR) const;
+
+  /// Call \p Receiver for each occurrence, in offset order, until it returns
+  /// false.
+  ///
+  /// \returns false if the occurrence stream is malformed.
+  bool forEachOccurrence(
+      llvm::function_ref<bool(unsigned Offset, unsigned SymbolIndex,
+                              SymbolRoleSet Roles)> Receiver) const;
+
+private:
+  const char *getStringTable() const {
+    return Buffer->getBufferStart() + sizeof(record::RecordHeader) +
+           getNumSymbols() * sizeof(record::SymbolEntry);
+  }
+};
+
+} // namespace index
+} // namespace clang
+
+#endif
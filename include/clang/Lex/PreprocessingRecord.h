@@ -17,7 +17,9 @@
 #include "clang/Basic/IdentifierTable.h"
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Lex/PPCallbacks.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/iterator.h"
@@ -331,6 +333,50 @@ namespace clang {
     /// \brief Mapping from MacroInfo structures to their definitions.
     llvm::DenseMap<const MacroInfo *, MacroDefinitionRecord *> MacroDefinitions;
 
+  public:
+    /// \brief A macro expansion or inclusion directive that was summarized
+    /// rather than recorded as a \c PreprocessedEntity.
+    struct SummarizedEntity {
+      /// \brief The offset of the entity within its file.
+      unsigned Offset;
+
+      /// \brief The kind of entity, either
+      /// \c PreprocessedEntity::MacroExpansionKind or
+      /// \c PreprocessedEntity::InclusionDirectiveKind.
+      unsigned Kind;
+
+      /// \brief The name of the expanded macro, or null for an inclusion
+      /// directive.
+      const IdentifierInfo *Name;
+    };
+
+  private:
+    /// \brief Whether entities are recorded for every file. When false, only
+    /// locations in \c RecordedFiles or \c RecordedRanges get full entities.
+    bool RecordAllFiles;
+
+    /// \brief The files whose entities are recorded in full.
+    llvm::DenseSet<FileID> RecordedFiles;
+
+    /// \brief Further source ranges whose entities are recorded in full.
+    SmallVector<SourceRange, 4> RecordedRanges;
+
+    /// \brief The summarized entities of each file that is not recorded in
+    /// full, in the order they appear in the file.
+    ///
+    /// Summaries are only kept for the current translation unit; they are not
+    /// serialized into precompiled headers.
+    llvm::DenseMap<FileID, std::vector<SummarizedEntity>> Summaries;
+
+    /// \brief Determine whether an entity at the given location should be
+    /// recorded in full.
+    bool shouldRecord(SourceLocation Loc) const;
+
+    /// \brief Summarize an entity at the given location, which must not be
+    /// recorded in full.
+    void addSummarizedEntity(SourceLocation Loc, unsigned Kind,
+                             const IdentifierInfo *Name);
+
     /// \brief External source of preprocessed entities.
     ExternalPreprocessingRecordSource *ExternalSource;
 
@@ -480,6 +526,33 @@ namespace clang {
     /// \c MacroInfo.
     MacroDefinitionRecord *findMacroDefinition(const MacroInfo *MI);
 
+    /// \brief Limit the record to the given files, or ranges within files.
+    ///
+    /// Entities at locations outside of these are summarized instead of
+    /// being recorded, and only entities seen after the call are affected.
+    /// The record keeps every entity until this is first called.
+    void limitToFile(FileID FID) {
+      RecordAllFiles = false;
+      RecordedFiles.insert(FID);
+    }
+    void limitToRange(SourceRange Range) {
+      RecordAllFiles = false;
+      RecordedRanges.push_back(Range);
+    }
+
+    /// \brief Determine whether every entity is recorded in full.
+    bool isRecordingAllFiles() const { return RecordAllFiles; }
+
+    /// \brief Retrieve the summarized entities in the file range \p R, in
+    /// source order.
+    ///
+    /// Both ends of \p R must be file locations in the same file; the search
+    /// is a binary search over that file's summary.
+    ArrayRef<SummarizedEntity> getSummarizedEntitiesInRange(SourceRange R);
+
+    /// \brief Retrieve the total number of summarized entities.
+    unsigned getNumSummarizedEntities() const;
+
     /// \brief Retrieve all ranges that got skipped while preprocessing.
     const std::vector<SourceRange> &getSkippedRanges() const {
       return SkippedRanges;
@@ -55,6 +55,15 @@ public:
   /// definitions and expansions.
   unsigned DetailedRecord : 1;
 
+  /// \brief Whether the detailed record should keep full entities only for
+  /// the main file and the files in \c DetailedRecordFiles, and summarize the
+  /// macro expansions and inclusions in all other files.
+  unsigned DetailedRecordMainFileOnly : 1;
+
+  /// \brief Additional files for which the detailed record keeps full
+  /// entities when \c DetailedRecordMainFileOnly is set.
+  std::vector<std::string> DetailedRecordFiles;
+
   /// The implicit PCH included at the start of the translation unit, or empty.
   std::string ImplicitPCHInclude;
 
@@ -141,6 +150,7 @@ public:
 
 public:
   PreprocessorOptions() : UsePredefines(true), DetailedRecord(false),
+                          DetailedRecordMainFileOnly(false),
                           DisablePCHValidation(false),
                           AllowPCHWithCompilerErrors(false),
                           DumpDeserializedPCHDecls(false),
@@ -27,11 +27,16 @@ public:
   /// Show brief documentation comments in code completion results.
   unsigned IncludeBriefComments : 1;
 
+  /// Reuse the already-parsed AST for the text before the completion point,
+  /// reparsing only the declaration that contains it.
+  unsigned ReuseParsedAST : 1;
+
   CodeCompleteOptions() :
       IncludeMacros(0),
       IncludeCodePatterns(0),
       IncludeGlobals(1),
-      IncludeBriefComments(0)
+      IncludeBriefComments(0),
+      ReuseParsedAST(0)
   { }
 };
 
@@ -204,6 +204,7 @@ namespace sema {
   class LambdaScopeInfo;
   class PossiblyUnreachableDiag;
   class TemplateDeductionInfo;
+  class TemplateInstantiationProfiler;
 }
 
 namespace threadSafety {
@@ -6734,6 +6735,22 @@ public:
   SmallVector<ActiveTemplateInstantiation, 16>
     ActiveTemplateInstantiations;
 
+  /// \brief The profiler that records the cost of each template
+  /// instantiation, or null if instantiations are not being profiled.
+  ///
+  /// \see enableTemplateInstantiationProfiling
+  std::unique_ptr<sema::TemplateInstantiationProfiler> InstantiationProfiler;
+
+  /// \brief Start recording the time and number of instantiations for each
+  /// template specialization and each caller.
+  void enableTemplateInstantiationProfiling();
+
+  /// \brief Retrieve the template instantiation profiler, or null if
+  /// instantiations are not being profiled.
+  sema::TemplateInstantiationProfiler *getTemplateInstantiationProfiler() const {
+    return InstantiationProfiler.get();
+  }
+
   /// Specializations whose definitions are currently being instantiated.
   llvm::DenseSet<std::pair<Decl *, unsigned>> InstantiatingSpecializations;
 
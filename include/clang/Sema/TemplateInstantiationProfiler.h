@@ -0,0 +1,146 @@
+//===- TemplateInstantiationProfiler.h - Instantiation cost -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the TemplateInstantiationProfiler class, which records
+//  the time spent and the number of instantiations performed for each
+//  template specialization.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SEMA_TEMPLATEINSTANTIATIONPROFILER_H
+#define LLVM_CLANG_SEMA_TEMPLATEINSTANTIATIONPROFILER_H
+
+#include "clang/AST/DeclBase.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Timer.h"
+#include <utility>
+
+namespace clang {
+
+class ASTContext;
+class FunctionDecl;
+
+namespace sema {
+
+/// \brief Records the cost of template instantiation, per template
+/// specialization and per (specialization, caller) pair.
+///
+/// Sema notifies the profiler whenever an \c InstantiatingTemplate is pushed
+/// or popped. The time attributed to an instantiation is split into
+/// inclusive time (including the nested instantiations it triggered) and
+/// exclusive time (excluding them), so that templates which are expensive
+/// only because of what they instantiate can be told apart from templates
+/// which are expensive in themselves.
+class TemplateInstantiationProfiler {
+public:
+  /// \brief Accumulated statistics for one specialization or one
+  /// (specialization, caller) pair.
+  struct Stats {
+    /// \brief The number of instantiations performed.
+    unsigned Count;
+
+    /// \brief Wall time spent in the instantiation, including nested
+    /// instantiations.
+    double InclusiveSeconds;
+
+    /// \brief Wall time spent in the instantiation, excluding nested
+    /// instantiations.
+    double ExclusiveSeconds;
+
+    Stats() : Count(0), InclusiveSeconds(0), ExclusiveSeconds(0) {}
+  };
+
+  typedef std::pair<const Decl *, const Decl *> CallerKey;
+
+private:
+  /// \brief An instantiation that has started but not finished.
+  struct ActiveFrame {
+    const Decl *Specialization;
+    const Decl *Caller;
+    double StartTime;
+    double NestedSeconds;
+  };
+
+  /// \brief Statistics for each specialization, keyed by the declaration
+  /// being instantiated, i.e. the \c Entity of the
+  /// \c ActiveTemplateInstantiation (e.g. \c vector<int>, or the
+  /// instantiated member function \c vector<int>::push_back).
+  llvm::DenseMap<const Decl *, Stats> SpecializationStats;
+
+  /// \brief Statistics for each (specialization, caller) pair, where the
+  /// caller is the specialization whose instantiation triggered this one, or
+  /// null for instantiations triggered from non-template code.
+  llvm::DenseMap<CallerKey, Stats> CallerStats;
+
+  /// \brief The stack of active instantiations, mirroring
+  /// \c Sema::ActiveTemplateInstantiations for the records that are
+  /// profiled.
+  SmallVector<ActiveFrame, 16> Active;
+
+  static double now() {
+    return llvm::TimeRecord::getCurrentTime(/*Start=*/true).getWallTime();
+  }
+
+public:
+  /// \brief Note that Sema started instantiating the given specialization.
+  void startInstantiation(const Decl *Specialization) {
+    ActiveFrame Frame;
+    Frame.Specialization = Specialization;
+    Frame.Caller = Active.empty() ? nullptr : Active.back().Specialization;
+    Frame.StartTime = now();
+    Frame.NestedSeconds = 0;
+    Active.push_back(Frame);
+  }
+
+  /// \brief Note that Sema finished the most recently started instantiation.
+  void finishInstantiation() {
+    assert(!Active.empty() && "Unbalanced template instantiation profile");
+    ActiveFrame Frame = Active.pop_back_val();
+    double Elapsed = now() - Frame.StartTime;
+    if (!Active.empty())
+      Active.back().NestedSeconds += Elapsed;
+
+    for (Stats *S :
+         {&SpecializationStats[Frame.Specialization],
+          &CallerStats[CallerKey(Frame.Specialization, Frame.Caller)]}) {
+      ++S->Count;
+      S->InclusiveSeconds += Elapsed;
+      S->ExclusiveSeconds += Elapsed - Frame.NestedSeconds;
+    }
+  }
+
+  /// \brief Whether any instantiation is currently being profiled.
+  bool isActive() const { return !Active.empty(); }
+
+  const llvm::DenseMap<const Decl *, Stats> &getSpecializationStats() const {
+    return SpecializationStats;
+  }
+
+  const llvm::DenseMap<CallerKey, Stats> &getCallerStats() const {
+    return CallerStats;
+  }
+
+  /// \brief Write the profile as a JSON document.
+  ///
+  /// The document has a "specializations" array with one object per
+  /// specialization, giving its qualified name with template arguments,
+  /// point of instantiation, count and inclusive and exclusive times,
+  /// sorted by decreasing exclusive time; a "templates" array with
+  /// the same fields summed over the specializations of each template,
+  /// keyed by the template they were instantiated from; and a "callers"
+  /// array with the same fields per (specialization, caller) pair.
+  void printJSON(raw_ostream &OS, const ASTContext &Context) const;
+};
+
+} // end namespace sema
+} // end namespace clang
+
+#endif
@@ -8,7 +8,8 @@
 //===----------------------------------------------------------------------===//
 //
 // This file defines the GlobalModuleIndex class, which manages a global index
-// containing all of the identifiers known to the various modules within a given
+// containing all of the identifiers, Objective-C selectors and named
+// declaration contexts known to the various modules within a given
 // subdirectory of the module cache. It is used to improve the performance of
 // queries such as "do any modules know about this identifier?"
 //
@@ -16,6 +17,7 @@
 #ifndef LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
 #define LLVM_CLANG_SERIALIZATION_GLOBALMODULEINDEX_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
@@ -70,6 +72,21 @@ class GlobalModuleIndex {
   /// GlobalModuleIndex.
   void *IdentifierIndex;
 
+  /// \brief The Objective-C selector hash table.
+  ///
+  /// This pointer actually points to a SelectorIndexTable object, keyed by
+  /// the selector's spelling (e.g., "initWithFoo:bar:"). It is null when the
+  /// index was written by a version that did not record selectors.
+  void *SelectorIndex;
+
+  /// \brief The declaration context hash table.
+  ///
+  /// This pointer actually points to a DeclContextIndexTable object, keyed
+  /// by the fully-qualified name of a namespace, record or Objective-C
+  /// container. It is null when the index was written by a version that did
+  /// not record declaration contexts.
+  void *DeclContextIndex;
+
   /// \brief Information about a given module file.
   struct ModuleInfo {
     ModuleInfo() : File(), Size(), ModTime() { }
@@ -115,7 +132,21 @@ class GlobalModuleIndex {
   /// \brief The number of identifier lookup hits, where we recognize the
   /// identifier.
   unsigned NumIdentifierLookupHits;
-  
+
+  /// \brief The number of selector lookups we performed.
+  unsigned NumSelectorLookups;
+
+  /// \brief The number of selector lookup hits, where we recognize the
+  /// selector.
+  unsigned NumSelectorLookupHits;
+
+  /// \brief The number of declaration context lookups we performed.
+  unsigned NumDeclContextLookups;
+
+  /// \brief The number of declaration context lookup hits, where we
+  /// recognize the declaration context.
+  unsigned NumDeclContextLookupHits;
+
   /// \brief Internal constructor. Use \c readIndex() to read an index.
   explicit GlobalModuleIndex(std::unique_ptr<llvm::MemoryBuffer> Buffer,
                              llvm::BitstreamCursor Cursor);
@@ -179,6 +210,32 @@ public:
   /// \returns true if the identifier is known to the index, false otherwise.
   bool lookupIdentifier(StringRef Name, HitSet &Hits);
 
+  /// \brief Look for all of the module files with methods for the given
+  /// Objective-C selector.
+  ///
+  /// \param SelectorName The spelling of the selector to look for, as
+  /// produced by \c Selector::getAsString().
+  ///
+  /// \param Hits Will be populated with the set of module files that have
+  /// instance or factory methods with this selector.
+  ///
+  /// \returns true if the selector is known to the index, false otherwise,
+  /// including when the index does not record selectors.
+  bool lookupSelector(StringRef SelectorName, HitSet &Hits);
+
+  /// \brief Look for all of the module files that contribute declarations to
+  /// the given named declaration context.
+  ///
+  /// \param QualifiedName The fully-qualified name of the namespace, record
+  /// or Objective-C container to look for.
+  ///
+  /// \param Hits Will be populated with the set of module files that have
+  /// declarations within this context.
+  ///
+  /// \returns true if the declaration context is known to the index, false
+  /// otherwise, including when the index does not record contexts.
+  bool lookupDeclContext(StringRef QualifiedName, HitSet &Hits);
+
   /// \brief Note that the given module file has been loaded.
   ///
   /// \returns false if the global module index has information about this
@@ -201,6 +258,36 @@ public:
   static ErrorCode writeIndex(FileManager &FileMgr,
                               const PCHContainerReader &PCHContainerRdr,
                               StringRef Path);
+
+  /// \brief Update the global index in the given directory after some of its
+  /// module files have changed.
+  ///
+  /// The given module files are always re-read. Every other module file in
+  /// the directory is stat'ed: its entry is copied from the existing index
+  /// if its size and modification time still match, and it is re-read
+  /// otherwise, as it is if the existing index has no entry for it. A
+  /// module file that changed but was not listed in \p ChangedModuleFiles
+  /// therefore never keeps a stale entry; listing it only saves the stat.
+  /// Entries for module files that no longer exist are dropped. If there is
+  /// no existing index, or it was written by an incompatible version, this
+  /// falls back to \c writeIndex().
+  ///
+  /// As with \c writeIndex(), the new index is written to a temporary file
+  /// and renamed into place while holding the index's \c LockFileManager
+  /// lock, so concurrent readers always see a complete index.
+  ///
+  /// \param FileMgr The file manager to use to load module files.
+  /// \param PCHContainerRdr - The PCHContainerOperations to use for loading and
+  /// creating modules.
+  /// \param Path The path to the directory containing module files, into
+  /// which the global index will be written.
+  /// \param ChangedModuleFiles The module files known to have been added or
+  /// rewritten since the index was last written. This list need not be
+  /// complete.
+  static ErrorCode updateIndex(FileManager &FileMgr,
+                               const PCHContainerReader &PCHContainerRdr,
+                               StringRef Path,
+                               llvm::ArrayRef<StringRef> ChangedModuleFiles);
 };
 }
 
@@ -121,6 +121,25 @@ enum IPAKind {
   IPAK_DynamicDispatchBifurcate = 5
 };
 
+/// \brief Describes the order in which the CoreEngine explores the worklist.
+enum ExplorationStrategyKind {
+  ESK_NotSet = 0,
+
+  /// Depth-first search.
+  ESK_DFS = 1,
+
+  /// Breadth-first search.
+  ESK_BFS = 2,
+
+  /// Breadth-first search across blocks, depth-first within a block.
+  ESK_BFSBlockDFSContents = 3,
+
+  /// Prefer work items whose CFG block has not been explored yet on any path,
+  /// then those whose block has been visited the fewest times on their own
+  /// path, falling back to depth-first order.
+  ESK_UnexploredFirst = 4
+};
+
 class AnalyzerOptions : public RefCountedBase<AnalyzerOptions> {
 public:
   typedef llvm::StringMap<std::string> ConfigTable;
@@ -200,6 +219,9 @@ private:
 
   /// Controls which C++ member functions will be considered for inlining.
   CXXInlineableMemberKind CXXMemberInliningMode;
+
+  /// \sa getExplorationStrategy
+  ExplorationStrategyKind ExplorationStrategy;
   
   /// \sa includeTemporaryDtorsInCFG
   Optional<bool> IncludeTemporaryDtorsInCFG;
@@ -265,6 +287,15 @@ private:
   /// \sa shouldWidenLoops
   Optional<bool> WidenLoops;
 
+  /// \sa getAnalysisShardCount
+  Optional<unsigned> AnalysisShardCount;
+
+  /// \sa getAnalysisShardIndex
+  Optional<unsigned> AnalysisShardIndex;
+
+  /// \sa getMaxMemoryPerTopLevelFunction
+  Optional<unsigned> MaxMemoryPerTopLevelFunction;
+
   /// A helper function that retrieves option for a given full-qualified
   /// checker name.
   /// Options for checkers can be specified via 'analyzer-config' command-line
@@ -370,6 +401,13 @@ public:
   /// \brief Returns the inter-procedural analysis mode.
   IPAKind getIPAMode();
 
+  /// \brief Returns the order in which the CoreEngine explores its worklist.
+  /// ESK_DFS is default.
+  ///
+  /// This is controlled by the 'exploration_strategy' config option, which
+  /// accepts "dfs", "bfs", "bfs_block_dfs_contents" and "unexplored_first".
+  ExplorationStrategyKind getExplorationStrategy();
+
   /// Returns the option controlling which C++ member functions will be
   /// considered for inlining.
   ///
@@ -525,6 +563,26 @@ public:
   /// This is controlled by the 'max-nodes' config option.
   unsigned getMaxNodesPerTopLevelFunction();
 
+  /// Returns the path of the on-disk function summary cache, or an empty
+  /// string if summaries are not persisted. When set, top level functions
+  /// that are unchanged since the run that wrote the cache, and that
+  /// produced no bug reports then, are not analyzed again.
+  ///
+  /// This is controlled by the 'summary-cache' config option.
+  StringRef getSummaryCachePath();
+
+  /// Returns the maximum number of megabytes the ExplodedGraph and program
+  /// states of a top level function may occupy before its analysis stops.
+  /// 0 is default and means no limit.
+  ///
+  /// Functions that hit the limit are reported like functions that hit
+  /// 'max-nodes', so the paths explored up to that point still produce
+  /// bug reports. With -analyzer-stats, the node, state and byte counters
+  /// of each graph are printed as well.
+  ///
+  /// This is controlled by the 'max-memory' config option.
+  unsigned getMaxMemoryPerTopLevelFunction();
+
   /// Returns true if lambdas should be inlined. Otherwise a sink node will be
   /// generated each time a LambdaExpr is visited.
   bool shouldInlineLambdas();
@@ -533,6 +591,30 @@ public:
   /// This is controlled by the 'widen-loops' config option.
   bool shouldWidenLoops();
 
+  /// Returns the number of shards the top-level declarations of the
+  /// translation unit are split into. 1 is default and analyzes all of them.
+  /// With N shards, the declarations are numbered in call-graph order and
+  /// only those whose number modulo N equals getAnalysisShardIndex() are
+  /// analyzed as top-level declarations.
+  ///
+  /// Each shard is meant to run as a separate analyzer process, so shards
+  /// share no AST, SourceManager or analyzer state and need no
+  /// synchronization; every shard still parses the translation unit. The
+  /// output of a shard is the same on every run, but the union of the
+  /// shards' output may differ from an unsharded run: function summaries
+  /// and inlining limits are per shard, and in the 'noredundancy' inlining
+  /// mode a function is only skipped as a top-level declaration if it was
+  /// inlined in the same shard.
+  ///
+  /// This is controlled by the 'analysis-shards' config option.
+  unsigned getAnalysisShardCount();
+
+  /// Returns the shard this analyzer process analyzes, from 0 to
+  /// getAnalysisShardCount() - 1.
+  ///
+  /// This is controlled by the 'analysis-shard-index' config option.
+  unsigned getAnalysisShardIndex();
+
 public:
   AnalyzerOptions() :
     AnalysisStoreOpt(RegionStoreModel),
@@ -556,7 +638,8 @@ public:
     InliningMode(NoRedundancy),
     UserMode(UMK_NotSet),
     IPAMode(IPAK_NotSet),
-    CXXMemberInliningMode() {}
+    CXXMemberInliningMode(),
+    ExplorationStrategy(ESK_NotSet) {}
 
 };
   
@@ -84,6 +84,10 @@ private:
   /// (This data is owned by AnalysisConsumer.)
   FunctionSummariesTy *FunctionSummaries;
 
+  /// Whether the last call to ExecuteWorkList stopped because the graph
+  /// exhausted its memory budget.
+  bool ExceededMemoryBudget;
+
   void generateNode(const ProgramPoint &Loc,
                     ProgramStateRef State,
                     ExplodedNode *Pred);
@@ -112,10 +116,14 @@ private:
   ExplodedNode *generateCallExitBeginNode(ExplodedNode *N);
 
 public:
-  /// Construct a CoreEngine object to analyze the provided CFG.
-  CoreEngine(SubEngine &subengine, FunctionSummariesTy *FS)
-      : SubEng(subengine), WList(WorkList::makeDFS()),
-        BCounterFactory(G.getAllocator()), FunctionSummaries(FS) {}
+  /// Construct a CoreEngine object to analyze the provided CFG, exploring
+  /// the worklist in the order selected by \p Opts.
+  CoreEngine(SubEngine &subengine, FunctionSummariesTy *FS,
+             AnalyzerOptions &Opts)
+      : SubEng(subengine),
+        WList(WorkList::make(Opts.getExplorationStrategy())),
+        BCounterFactory(G.getAllocator()), FunctionSummaries(FS),
+        ExceededMemoryBudget(false) {}
 
   /// getGraph - Returns the exploded graph.
   ExplodedGraph &getGraph() { return G; }
@@ -138,6 +146,7 @@ public:
   // Functions for external checking of whether we have unfinished work
   bool wasBlockAborted() const { return !blocksAborted.empty(); }
   bool wasBlocksExhausted() const { return !blocksExhausted.empty(); }
+  bool wasMemoryBudgetExceeded() const { return ExceededMemoryBudget; }
   bool hasWorkRemaining() const { return wasBlocksExhausted() || 
                                          WList->hasWork() || 
                                          wasBlockAborted(); }
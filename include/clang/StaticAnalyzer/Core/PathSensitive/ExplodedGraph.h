@@ -285,7 +285,28 @@ protected:
   /// Counter to determine when to reclaim nodes.
   unsigned ReclaimCounter;
 
+  /// The number of nodes reclaimed so far.
+  unsigned NumReclaimedNodes;
+
+  /// The number of bytes the graph's allocator may hold before the analysis
+  /// of the current function is stopped. The allocator is shared with the
+  /// ProgramStateManager, so this bounds nodes and states together.
+  ///
+  /// If this is 0, memory is not bounded.
+  uint64_t MemoryBudget;
+
 public:
+  /// Live counters describing the memory used by the graph.
+  struct Stats {
+    /// The number of nodes currently in the graph.
+    unsigned LiveNodes;
+    /// The number of nodes reclaimed since the graph was created.
+    unsigned ReclaimedNodes;
+    /// The number of reclaimed nodes waiting to be reused.
+    unsigned FreeNodes;
+    /// The number of bytes held by the allocator for nodes and states.
+    uint64_t AllocatedBytes;
+  };
 
   /// \brief Retrieve the node associated with a (Location,State) pair,
   ///  where the 'Location' is a ProgramPoint in the CFG.  If no node for
@@ -395,6 +416,43 @@ public:
   /// was called.
   void reclaimRecentlyAllocatedNodes();
 
+  /// Bound the memory held by the graph's allocator to \p Bytes.
+  ///
+  /// Until three quarters of the budget are in use, reclamation follows the
+  /// interval set by enableNodeReclamation(). From then on,
+  /// reclaimRecentlyAllocatedNodes() reclaims on every call instead of
+  /// waiting for the interval to elapse. Which nodes are reclaimed does not
+  /// change: the rules of shouldCollect() still apply, so tagged nodes,
+  /// PostStore nodes and the nodes of interesting lvalues that BugReporter
+  /// visitors read stay in the graph. If reclamation is disabled (e.g.
+  /// 'graph-trim-interval=0'), it stays disabled. Once the budget is
+  /// exhausted the CoreEngine stops exploring the current function.
+  void enableMemoryBudget(uint64_t Bytes) { MemoryBudget = Bytes; }
+
+  /// Returns the number of bytes held by the allocator for nodes and states.
+  uint64_t getAllocatedBytes() { return getAllocator().getTotalMemory(); }
+
+  /// Returns true if nodes should be reclaimed as aggressively as possible
+  /// because the graph is close to its memory budget.
+  bool isNearMemoryBudget() {
+    return MemoryBudget && getAllocatedBytes() >= MemoryBudget / 4 * 3;
+  }
+
+  /// Returns true if the graph has exhausted its memory budget.
+  bool isOverMemoryBudget() {
+    return MemoryBudget && getAllocatedBytes() > MemoryBudget;
+  }
+
+  /// Returns the current values of the graph's memory counters.
+  Stats getStats() {
+    Stats S;
+    S.LiveNodes = NumNodes;
+    S.ReclaimedNodes = NumReclaimedNodes;
+    S.FreeNodes = FreeNodes.size();
+    S.AllocatedBytes = getAllocatedBytes();
+    return S;
+  }
+
   /// \brief Returns true if nodes for the given expression kind are always
   ///        kept around.
   static bool isInterestingLValueExpr(const Expr *Ex);
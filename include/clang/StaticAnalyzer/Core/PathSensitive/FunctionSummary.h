@@ -16,6 +16,7 @@
 
 #include "clang/AST/Decl.h"
 #include "clang/Basic/LLVM.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/FunctionSummaryCache.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
@@ -133,6 +134,37 @@ public:
   unsigned getTotalNumBasicBlocks();
   unsigned getTotalNumVisitedBasicBlocks();
 
+  /// Seed the inlining decision of \p D from a summary loaded from the
+  /// on-disk cache.
+  ///
+  /// Block coverage and inline counts are not imported: callers analyzed in
+  /// this run record their own, and importing the previous run's would count
+  /// them twice.
+  void importInlineDecision(const Decl *D,
+                            const PersistentFunctionSummary &S) {
+    if (!S.InlineChecked)
+      return;
+    MapTy::iterator I = findOrInsertSummary(D);
+    I->second.InlineChecked = true;
+    I->second.MayInline = S.MayInline;
+  }
+
+  /// Account for the inlines of \p D performed by a top level function that
+  /// this run skips, as recorded in that function's cached summary.
+  void addInlinesFromSkippedCaller(const Decl *D, unsigned TimesInlined) {
+    MapTy::iterator I = findOrInsertSummary(D);
+    I->second.TimesInlined += TimesInlined;
+  }
+
+  /// Fill in the inlining decision this run recorded for \p D.
+  void exportInlineDecision(const Decl *D, PersistentFunctionSummary &S) {
+    MapTy::const_iterator I = Map.find(D);
+    if (I == Map.end())
+      return;
+    S.InlineChecked = I->second.InlineChecked;
+    S.MayInline = I->second.MayInline;
+  }
+
 };
 
 }} // end clang ento namespaces
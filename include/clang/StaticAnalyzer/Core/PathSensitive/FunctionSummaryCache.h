@@ -0,0 +1,177 @@
+//== FunctionSummaryCache.h - On-disk cache of function summaries -*- C++ -*-//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines FunctionSummaryCache, which persists the per-function
+// summaries gathered by the analyzer across runs so that functions whose
+// bodies have not changed can be skipped on incremental analysis.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_STATICANALYZER_CORE_PATHSENSITIVE_FUNCTIONSUMMARYCACHE_H
+#define LLVM_CLANG_STATICANALYZER_CORE_PATHSENSITIVE_FUNCTIONSUMMARYCACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include <string>
+
+namespace clang {
+
+class Decl;
+
+namespace ento {
+
+/// A callee inlined while analyzing a function as a top level function.
+struct PersistentInlinedCallee {
+  std::string USR;
+
+  /// The body hash the callee had at the time. If it has changed, the
+  /// caller must be analyzed again.
+  uint64_t BodyHash;
+
+  /// The number of times the callee was inlined into this caller.
+  unsigned TimesInlined;
+
+  PersistentInlinedCallee() : BodyHash(0), TimesInlined(0) {}
+};
+
+/// The summary of one function as recorded in the on-disk cache.
+///
+/// Only what a later run needs in order to skip the function is recorded.
+/// Block coverage and the total inline counts are properties of a whole
+/// run and are not persisted; a run that skips the function only accounts
+/// for the inlines the function itself performed, through
+/// \c InlinedCallees.
+struct PersistentFunctionSummary {
+  /// The hash computed by \c FunctionSummaryCache::computeBodyHash().
+  uint64_t BodyHash;
+
+  /// The callees that were inlined while analyzing the function as a top
+  /// level function.
+  SmallVector<PersistentInlinedCallee, 4> InlinedCallees;
+
+  /// True if the function has been checked against the rules for which
+  /// functions may be inlined, and MayInline holds the result.
+  bool InlineChecked;
+
+  /// True if the function may be inlined.
+  bool MayInline;
+
+  /// True if analyzing the function as a top level function produced any
+  /// bug reports.
+  ///
+  /// The cache does not store the reports themselves, so such functions are
+  /// always analyzed again.
+  bool HadBugReports;
+
+  PersistentFunctionSummary()
+      : BodyHash(0), InlineChecked(false), MayInline(false),
+        HadBugReports(false) {}
+};
+
+/// An on-disk cache of function summaries, keyed by USR.
+///
+/// The cache is read when a translation unit's analysis starts and written
+/// back when it ends. A function whose summary matches its current body
+/// hash and the body hashes of everything it inlined, and which produced no
+/// bug reports, does not need to be analyzed as a top level function again.
+/// Its inlining decision, and the inlines it performed, seed the current
+/// run's FunctionSummariesTy so that callers see the same inlining behavior.
+///
+/// Analyzer processes running in parallel on a project share one cache
+/// file. Each process only writes back the summaries it updated, merged
+/// into the file's current contents while holding an llvm::LockFileManager
+/// lock on the file, so no process discards what another one saved. The
+/// merged cache is written to a temporary file and renamed into place, so
+/// readers never observe a partial file.
+class FunctionSummaryCache {
+  std::string Path;
+  llvm::StringMap<PersistentFunctionSummary> Summaries;
+
+  /// The USRs whose summaries were updated since the cache was loaded.
+  llvm::StringSet<> Updated;
+
+public:
+  explicit FunctionSummaryCache(StringRef Path) : Path(Path) {}
+
+  /// Compute the body hash for the given function, method or block.
+  ///
+  /// The hash covers the function's AST after macro expansion and semantic
+  /// analysis, not its text, so it changes when an included header or
+  /// macro changes what the body means. It also covers, for each
+  /// declaration the body or signature references, the declaration's USR,
+  /// type and attributes, so that a change to a callee's declaration (e.g.
+  /// adding \c noreturn or \c nonnull) is detected; callee bodies are
+  /// covered through \c PersistentFunctionSummary::InlinedCallees. The
+  /// analyzer and language options that affect the analysis are included
+  /// as well.
+  static uint64_t computeBodyHash(const Decl *D);
+
+  /// Read the cache file, replacing any summaries in memory.
+  ///
+  /// A missing, unreadable or out-of-date cache file is not an error; the
+  /// cache simply starts out empty.
+  void load();
+
+  /// Merge the summaries updated since the cache was loaded into the cache
+  /// file, if there are any.
+  ///
+  /// The file is locked with llvm::LockFileManager and read again, the
+  /// updated summaries replace the ones it holds for the same USRs, and the
+  /// result is written back; summaries written by other processes since
+  /// \c load() are kept. If the lock cannot be acquired in time, nothing is
+  /// written and the summaries of this run are lost, which only costs a
+  /// re-analysis next time.
+  ///
+  /// \returns true if an error occurred.
+  bool save();
+
+  /// Retrieve the summary for the function with the given USR, if it was
+  /// recorded for the same body hash.
+  const PersistentFunctionSummary *lookup(StringRef USR,
+                                          uint64_t BodyHash) const {
+    auto Known = Summaries.find(USR);
+    if (Known == Summaries.end() || Known->second.BodyHash != BodyHash)
+      return nullptr;
+    return &Known->second;
+  }
+
+  /// Record the summary for the function with the given USR.
+  void update(StringRef USR, PersistentFunctionSummary Summary) {
+    Summaries[USR] = std::move(Summary);
+    Updated.insert(USR);
+  }
+
+  /// Returns true if the function with the given USR and body hash can be
+  /// skipped as a top level function: it was analyzed before without bug
+  /// reports, and neither it nor anything it inlined has changed.
+  ///
+  /// \param CurrentHash Returns the current body hash of the function with
+  /// the given USR, or 0 if it is not defined in this translation unit.
+  template <typename HashLookup>
+  bool isUnchanged(StringRef USR, uint64_t BodyHash,
+                   HashLookup CurrentHash) const {
+    const PersistentFunctionSummary *S = lookup(USR, BodyHash);
+    if (!S || S->HadBugReports)
+      return false;
+    for (const PersistentInlinedCallee &Callee : S->InlinedCallees)
+      if (CurrentHash(Callee.USR) != Callee.BodyHash)
+        return false;
+    return true;
+  }
+
+  StringRef getPath() const { return Path; }
+  unsigned size() const { return Summaries.size(); }
+};
+
+} // end ento namespace
+} // end clang namespace
+
+#endif
@@ -505,6 +505,14 @@ public:
 
   llvm::BumpPtrAllocator& getAllocator() { return Alloc; }
 
+  /// Returns the number of distinct states currently alive. States are
+  /// uniqued through StateSet, so equal states are shared by every node
+  /// that reaches them.
+  unsigned getNumLiveStates() const { return StateSet.size(); }
+
+  /// Returns the number of released states waiting to be reused.
+  unsigned getNumFreeStates() const { return freeStates.size(); }
+
   MemRegionManager& getRegionManager() {
     return svalBuilder->getRegionManager();
   }
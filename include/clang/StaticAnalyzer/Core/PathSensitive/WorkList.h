@@ -15,6 +15,7 @@
 #ifndef LLVM_CLANG_STATICANALYZER_CORE_PATHSENSITIVE_WORKLIST_H
 #define LLVM_CLANG_STATICANALYZER_CORE_PATHSENSITIVE_WORKLIST_H
 
+#include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/BlockCounter.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExplodedGraph.h"
 #include <cassert>
@@ -91,6 +92,31 @@ public:
   static WorkList *makeDFS();
   static WorkList *makeBFS();
   static WorkList *makeBFSBlockDFSContents();
+
+  /// Create a priority-queue worklist that favors coverage.
+  ///
+  /// Units whose (stack frame, CFG block) pair has not been dequeued on any
+  /// path yet come first. Among the rest, units whose block has been
+  /// visited the fewest times along their own path, according to their
+  /// BlockCounter, come first. Ties are broken in LIFO order, so on code
+  /// without loops this behaves like makeDFS().
+  static WorkList *makeUnexploredFirst();
+
+  /// Create the worklist for the given exploration strategy.
+  static WorkList *make(ExplorationStrategyKind K) {
+    switch (K) {
+    case ESK_NotSet:
+    case ESK_DFS:
+      return makeDFS();
+    case ESK_BFS:
+      return makeBFS();
+    case ESK_BFSBlockDFSContents:
+      return makeBFSBlockDFSContents();
+    case ESK_UnexploredFirst:
+      return makeUnexploredFirst();
+    }
+    llvm_unreachable("Unknown exploration strategy");
+  }
 };
 
 } // end GR namespace